@@ -0,0 +1,574 @@
+// micro-benchmarks for the transform and math hot paths
+// usage: bench [--json <file>] [--compare <baseline.json>]
+// the SSE cases need GLM_FORCE_INTRINSICS, which both makefiles define for every file
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/simd/matrix.h>
+
+#include "../src/animation.h"
+#include "../src/collision.h"
+#include "../src/ecs.h"
+#include "../src/physics.h"
+#include "../src/picking.h"
+#include "../src/scene_graph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#endif
+
+const int OBJECT_COUNT = 1024;           // objects per batch in the transform cases
+const int COLLISION_BODIES = 100000;     // moving shapes in the collision cases
+const int COLLISION_SWEEPS = 1000;       // fast drags swept through them
+const int PHYSICS_BODIES = 20000;        // rigid bodies in the physics cases
+const int ANIMATED_OBJECTS = 100000;     // objects in the animation case, one track per channel
+const double MIN_RUN_SECONDS = 0.05;     // each repetition runs at least this long
+const double MIN_CHUNK_SECONDS = 0.001;  // the clock is read once per chunk of calls this long
+const int REPETITIONS = 5;               // the fastest repetition is reported
+
+// structure to store the result of one benchmark case
+struct BenchResult {
+    std::string name;
+    double nsPerOp;
+    double opsPerSecond;
+    double cyclesPerOp; // 0 where no cycle counter is available
+};
+
+// optimisation barrier: results are folded in here so the compiler can't drop the work
+volatile float benchSink = 0.0f;
+
+static uint64_t readCycles() {
+#ifdef BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// case runner: call body (which performs opsPerCall operations) until the run is long enough,
+// repeat and keep the fastest repetition
+// the calls are made in chunks and the clock is only read between chunks, so reading it (tens of
+// nanoseconds) doesn't weigh on cases that take about as long; the chunk size is calibrated
+// first, doubling until a chunk takes at least MIN_CHUNK_SECONDS
+template <typename Body>
+BenchResult runBench(const std::string& name, int opsPerCall, Body body) {
+    body(); // warm up caches and branch predictors
+
+    unsigned long chunk = 1;
+    while (true) {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned long i = 0; i < chunk; i++)
+            body();
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= MIN_CHUNK_SECONDS)
+            break;
+        chunk *= 2;
+    }
+
+    double bestNs = 1e30, bestCycles = 0.0;
+    for (int repetition = 0; repetition < REPETITIONS; repetition++) {
+        unsigned long calls = 0;
+        auto start = std::chrono::steady_clock::now();
+        uint64_t startCycles = readCycles();
+        double elapsed = 0.0;
+        do {
+            for (unsigned long i = 0; i < chunk; i++)
+                body();
+            calls += chunk;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < MIN_RUN_SECONDS);
+        uint64_t cycles = readCycles() - startCycles;
+
+        double ops = (double)calls * opsPerCall;
+        if (elapsed * 1e9 / ops < bestNs) {
+            bestNs = elapsed * 1e9 / ops;
+            bestCycles = cycles / ops;
+        }
+    }
+    return {name, bestNs, 1e9 / bestNs, bestCycles};
+}
+
+// structure to store the per object transform inputs in both layouts
+struct TransformInputs {
+    std::vector<glm::vec3> translations;
+    std::vector<float> rotations;
+    std::vector<float> scales;
+
+    // SoA copies for the batched variant, the rotation as its cosine and sine
+    std::vector<float> tx, ty;
+    std::vector<float> cosines, sines;
+};
+
+static TransformInputs makeInputs(std::mt19937& random) {
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    TransformInputs inputs;
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        inputs.translations.push_back(glm::vec3(unit(random), unit(random), 0.0f));
+        inputs.rotations.push_back(unit(random) * 3.14159f);
+        inputs.scales.push_back(unit(random) * 0.5f);
+        inputs.tx.push_back(inputs.translations.back().x);
+        inputs.ty.push_back(inputs.translations.back().y);
+        inputs.cosines.push_back(std::cos(inputs.rotations.back()));
+        inputs.sines.push_back(std::sin(inputs.rotations.back()));
+    }
+    return inputs;
+}
+
+// transform cases: the mat4 TRS chain of main(), a direct 2D affine build and a vectorised SoA build
+static void benchTransforms(std::vector<BenchResult>& results, const TransformInputs& in) {
+    std::vector<glm::mat4> matrices(OBJECT_COUNT);
+    results.push_back(runBench("trs_mat4", OBJECT_COUNT, [&]() {
+        for (int i = 0; i < OBJECT_COUNT; i++) {
+            glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(-0.5f, 0.0f, 0.0f));
+            transform = glm::translate(transform, in.translations[i]);
+            transform = glm::rotate(transform, in.rotations[i], glm::vec3(0.0f, 0.0f, 1.0f));
+            transform = glm::scale(transform, glm::vec3(1.0f + in.scales[i], 1.0f + in.scales[i], 1.0f));
+            matrices[i] = transform;
+        }
+        benchSink = benchSink + matrices[OBJECT_COUNT - 1][3][0];
+    }));
+
+    // 2D affine: the same transform written out as 2x3, no matrix products
+    std::vector<glm::mat3x2> affine(OBJECT_COUNT);
+    results.push_back(runBench("trs_affine2d", OBJECT_COUNT, [&]() {
+        for (int i = 0; i < OBJECT_COUNT; i++) {
+            float c = std::cos(in.rotations[i]), s = std::sin(in.rotations[i]);
+            float scale = 1.0f + in.scales[i];
+            affine[i] = glm::mat3x2(c * scale, s * scale, -s * scale, c * scale,
+                -0.5f + in.translations[i].x, in.translations[i].y);
+        }
+        benchSink = benchSink + affine[OBJECT_COUNT - 1][2][0];
+    }));
+
+    // batched SoA: one array per matrix element, built four objects at a time in glm::vec4 lanes
+    // (SSE with GLM_FORCE_INTRINSICS); the rotation comes in as cosine and sine, kept per object
+    // while its angle doesn't change, so unlike trs_affine2d there is no cos/sin in the loop
+    static_assert(OBJECT_COUNT % 4 == 0, "the SoA batch works in groups of four objects");
+    std::vector<float> m00(OBJECT_COUNT), m01(OBJECT_COUNT), m10(OBJECT_COUNT), m11(OBJECT_COUNT);
+    std::vector<float> m20(OBJECT_COUNT), m21(OBJECT_COUNT);
+    results.push_back(runBench("trs_affine2d_soa", OBJECT_COUNT, [&]() {
+        for (int i = 0; i < OBJECT_COUNT; i += 4) {
+            glm::vec4 c = glm::make_vec4(&in.cosines[i]);
+            glm::vec4 s = glm::make_vec4(&in.sines[i]);
+            glm::vec4 scale = 1.0f + glm::make_vec4(&in.scales[i]);
+            glm::vec4 x = glm::make_vec4(&in.tx[i]) - 0.5f;
+            glm::vec4 y = glm::make_vec4(&in.ty[i]);
+            std::memcpy(&m00[i], glm::value_ptr(c * scale), sizeof(glm::vec4));
+            std::memcpy(&m01[i], glm::value_ptr(s * scale), sizeof(glm::vec4));
+            std::memcpy(&m10[i], glm::value_ptr(-s * scale), sizeof(glm::vec4));
+            std::memcpy(&m11[i], glm::value_ptr(c * scale), sizeof(glm::vec4));
+            std::memcpy(&m20[i], glm::value_ptr(x), sizeof(glm::vec4));
+            std::memcpy(&m21[i], glm::value_ptr(y), sizeof(glm::vec4));
+        }
+        benchSink = benchSink + m00[OBJECT_COUNT - 1] + m21[OBJECT_COUNT - 1];
+    }));
+}
+
+// matrix cases: glm::inverse / glm::determinant against the SSE versions in simd/matrix.h
+static void benchMatrices(std::vector<BenchResult>& results, const TransformInputs& in) {
+    std::vector<glm::mat4> matrices(OBJECT_COUNT);
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        matrices[i] = glm::rotate(glm::translate(glm::mat4(1.0f), in.translations[i]),
+            in.rotations[i], glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+
+    results.push_back(runBench("inverse_scalar", OBJECT_COUNT, [&]() {
+        float sum = 0.0f;
+        for (const glm::mat4& matrix : matrices)
+            sum += glm::inverse(matrix)[3][0];
+        benchSink = benchSink + sum;
+    }));
+    results.push_back(runBench("determinant_scalar", OBJECT_COUNT, [&]() {
+        float sum = 0.0f;
+        for (const glm::mat4& matrix : matrices)
+            sum += glm::determinant(matrix);
+        benchSink = benchSink + sum;
+    }));
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    glm_vec4* columns = new glm_vec4[OBJECT_COUNT * 4];
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        for (int c = 0; c < 4; c++)
+            columns[i * 4 + c] = _mm_loadu_ps(&matrices[i][c][0]);
+    }
+
+    results.push_back(runBench("inverse_simd", OBJECT_COUNT, [&]() {
+        glm_vec4 out[4];
+        __m128 sum = _mm_setzero_ps();
+        for (int i = 0; i < OBJECT_COUNT; i++) {
+            glm_mat4_inverse(&columns[i * 4], out);
+            sum = _mm_add_ps(sum, out[3]);
+        }
+        benchSink = benchSink + _mm_cvtss_f32(sum);
+    }));
+    results.push_back(runBench("determinant_simd", OBJECT_COUNT, [&]() {
+        __m128 sum = _mm_setzero_ps();
+        for (int i = 0; i < OBJECT_COUNT; i++)
+            sum = _mm_add_ps(sum, glm_mat4_determinant(&columns[i * 4]));
+        benchSink = benchSink + _mm_cvtss_f32(sum);
+    }));
+    delete[] columns;
+#endif
+}
+
+// packing cases: the vertex/color packing functions of glm/gtc/packing.hpp
+static void benchPacking(std::vector<BenchResult>& results, std::mt19937& random) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<glm::vec4> values(OBJECT_COUNT);
+    for (glm::vec4& value : values)
+        value = glm::vec4(unit(random), unit(random), unit(random), unit(random));
+
+    results.push_back(runBench("pack_unorm4x8", OBJECT_COUNT, [&]() {
+        uint32_t bits = 0;
+        for (const glm::vec4& value : values)
+            bits ^= glm::packUnorm4x8(value);
+        benchSink = benchSink + (float)bits;
+    }));
+    results.push_back(runBench("pack_snorm2x16", OBJECT_COUNT, [&]() {
+        uint32_t bits = 0;
+        for (const glm::vec4& value : values)
+            bits ^= glm::packSnorm2x16(glm::vec2(value));
+        benchSink = benchSink + (float)bits;
+    }));
+    results.push_back(runBench("pack_half2x16", OBJECT_COUNT, [&]() {
+        uint32_t bits = 0;
+        for (const glm::vec4& value : values)
+            bits ^= glm::packHalf2x16(glm::vec2(value));
+        benchSink = benchSink + (float)bits;
+    }));
+    results.push_back(runBench("unpack_half2x16", OBJECT_COUNT, [&]() {
+        float sum = 0.0f;
+        for (int i = 0; i < OBJECT_COUNT; i++)
+            sum += glm::unpackHalf2x16((uint32_t)i * 2654435761u).x;
+        benchSink = benchSink + sum;
+    }));
+}
+
+// picking case: the decagon and house outlines of main.cpp against random cursor positions
+static void benchPicking(std::vector<BenchResult>& results, std::mt19937& random) {
+    std::vector<glm::vec2> decagon;
+    for (int i = 0; i < 10; i++)
+        decagon.push_back(0.5f * glm::vec2(std::cos(i * 0.6283185f), std::sin(i * 0.6283185f)));
+    std::vector<glm::vec2> house = {
+        {-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}, {0.0f, 0.75f}, {-0.5f, 0.5f}
+    };
+
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<glm::vec2> points(OBJECT_COUNT);
+    for (glm::vec2& point : points)
+        point = glm::vec2(unit(random), unit(random));
+
+    results.push_back(runBench("pick_point_in_polygon", OBJECT_COUNT * 2, [&]() {
+        int hits = 0;
+        for (const glm::vec2& point : points) {
+            hits += pointInPolygon(point, decagon.data(), (int)decagon.size());
+            hits += pointInPolygon(point, house.data(), (int)house.size());
+        }
+        benchSink = benchSink + (float)hits;
+    }));
+}
+
+// scene graph cases: OBJECT_COUNT roots with three children each, updated with every root dirty,
+// with one root dirty and with nothing dirty (the static scene)
+static void benchSceneGraph(std::vector<BenchResult>& results, const TransformInputs& in) {
+    SceneGraph graph = sceneGraphInit();
+    std::vector<int> roots;
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        int root = addSceneNode(graph, -1, glm::mat4(1.0f));
+        roots.push_back(root);
+        for (int child = 0; child < 3; child++)
+            addSceneNode(graph, root, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.5f, 0.0f)));
+    }
+    updateWorldTransforms(graph);
+
+    float angle = 0.0f;
+    results.push_back(runBench("scene_update_all_dirty", OBJECT_COUNT, [&]() {
+        angle += 0.01f;
+        for (int i = 0; i < OBJECT_COUNT; i++)
+            setLocalTransform(graph, roots[i], glm::rotate(glm::mat4(1.0f), angle + in.rotations[i],
+                glm::vec3(0.0f, 0.0f, 1.0f)));
+        benchSink = benchSink + (float)updateWorldTransforms(graph);
+    }));
+    results.push_back(runBench("scene_update_one_dirty", 1, [&]() {
+        angle += 0.01f;
+        setLocalTransform(graph, roots[OBJECT_COUNT / 2], glm::rotate(glm::mat4(1.0f), angle,
+            glm::vec3(0.0f, 0.0f, 1.0f)));
+        benchSink = benchSink + (float)updateWorldTransforms(graph);
+    }));
+    results.push_back(runBench("scene_update_static", 1, [&]() {
+        benchSink = benchSink + (float)updateWorldTransforms(graph);
+    }));
+}
+
+// ECS cases: the motion system over OBJECT_COUNT entities spread over two archetypes, and
+// creating and destroying an entity (swap removal inside its archetype)
+static void benchEcs(std::vector<BenchResult>& results, const TransformInputs& in) {
+    EcsWorld world;
+    ComponentMask moving = componentBit<Transform2D>() | componentBit<Velocity>();
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        Entity entity = createEntity(world, i % 2 ? moving : moving | componentBit<Color>());
+        getComponent<Transform2D>(world, entity)->position = glm::vec2(in.translations[i]);
+        *getComponent<Velocity>(world, entity) = {glm::vec2(in.scales[i], in.rotations[i]), in.rotations[i]};
+    }
+
+    results.push_back(runBench("ecs_motion_system", OBJECT_COUNT, [&]() {
+        forEachChunk(world, moving, [&](Chunk& chunk) {
+            Transform2D* transforms = chunkComponents<Transform2D>(chunk);
+            const Velocity* velocities = chunkComponents<Velocity>(chunk);
+            for (int i = 0; i < chunk.count; i++) {
+                transforms[i].position += velocities[i].linear * 0.001f;
+                transforms[i].rotation += velocities[i].angular * 0.001f;
+            }
+        });
+        benchSink = benchSink + getComponent<Transform2D>(world, Entity{0, 1})->position.x;
+    }));
+    results.push_back(runBench("ecs_create_destroy", 1, [&]() {
+        destroyEntity(world, createEntity(world, moving | componentBit<Pickable>()));
+    }));
+}
+
+// collision cases: COLLISION_BODIES decagons and houses drifting over a field sized for a few
+// overlaps per body; reported per candidate pair (broad phase output, narrow phase input) and
+// per body, so ops/s of the first case is the pairs processed per second
+static void benchCollision(std::vector<BenchResult>& results, std::mt19937& random) {
+    CollisionWorld world;
+    std::vector<glm::vec2> decagon;
+    for (int i = 0; i < 10; i++)
+        decagon.push_back(0.5f * glm::vec2(std::cos(i * 0.6283185f), std::sin(i * 0.6283185f)));
+    int decagonShape = addCollisionShape(world, decagon);
+    int houseShape = addCollisionShape(world, {
+        {-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}, {0.0f, 0.75f}, {-0.5f, 0.5f}
+    });
+
+    const float field = std::sqrt((float)COLLISION_BODIES) * 1.5f;
+    std::uniform_real_distribution<float> position(0.0f, field), drift(-0.01f, 0.01f), angle(0.0f, 6.283f);
+    std::vector<CollisionBody> bodies(COLLISION_BODIES);
+    std::vector<glm::vec2> drifts(COLLISION_BODIES);
+    for (int i = 0; i < COLLISION_BODIES; i++) {
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(position(random), position(random), 0.0f));
+        bodies[i] = {i % 2 ? decagonShape : houseShape, i,
+            glm::rotate(transform, angle(random), glm::vec3(0.0f, 0.0f, 1.0f))};
+        drifts[i] = glm::vec2(drift(random), drift(random));
+    }
+
+    std::vector<ContactPair> contacts;
+    detectCollisions(world, bodies, contacts);
+    int candidates = (int)world.candidatePairs;
+
+    int step = 0;
+    auto detect = [&]() {
+        // drift back and forth, so the bodies keep moving without leaving the field
+        float direction = (step++ / 8) % 2 ? -1.0f : 1.0f;
+        for (int i = 0; i < COLLISION_BODIES; i++) {
+            bodies[i].transform[3][0] += drifts[i].x * direction;
+            bodies[i].transform[3][1] += drifts[i].y * direction;
+        }
+        detectCollisions(world, bodies, contacts);
+        benchSink = benchSink + (float)contacts.size();
+    };
+    results.push_back(runBench("collide_100k_per_pair", candidates, detect));
+    results.push_back(runBench("collide_100k_per_body", COLLISION_BODIES, detect));
+    std::cout << "INFO: collision field " << COLLISION_BODIES << " bodies, " << candidates <<
+        " candidate pairs, " << contacts.size() << " contacts" << std::endl;
+
+    // sweeps: fast drags of single bodies across the field, each about twenty bodies long
+    std::uniform_real_distribution<float> reach(-30.0f, 30.0f);
+    std::vector<GroupSweep> sweeps(COLLISION_SWEEPS);
+    for (int i = 0; i < COLLISION_SWEEPS; i++)
+        sweeps[i] = {i * (COLLISION_BODIES / COLLISION_SWEEPS), glm::vec2(reach(random), reach(random))};
+    std::vector<SweepHit> hits;
+    sweepCollisions(world, bodies, sweeps, hits);
+    int impacts = 0;
+    for (const SweepHit& hit : hits)
+        impacts += hit.body >= 0;
+    results.push_back(runBench("sweep_1k_in_100k", COLLISION_SWEEPS, [&]() {
+        sweepCollisions(world, bodies, sweeps, hits);
+        benchSink = benchSink + hits[0].time;
+    }));
+    std::cout << "INFO: " << COLLISION_SWEEPS << " sweeps, " << world.candidatePairs <<
+        " candidate pairs, " << impacts << " impacts" << std::endl;
+}
+
+// physics cases: PHYSICS_BODIES decagons dropped into a box, a full step (contacts and solve) per
+// call, once per thread count up to the number of cores; how many bodies fit into a 60 Hz frame
+// follows from the time per body
+static void benchPhysics(std::vector<BenchResult>& results, std::mt19937& random) {
+    CollisionWorld collision;
+    std::vector<glm::vec2> decagon;
+    for (int i = 0; i < 10; i++)
+        decagon.push_back(0.5f * glm::vec2(std::cos(i * 0.6283185f), std::sin(i * 0.6283185f)));
+    int shape = addCollisionShape(collision, decagon);
+    MassProperties mass = polygonMass(decagon, glm::vec2(0.0f));
+
+    // the box leaves about a body width of room per body, so the pile keeps a few contacts each
+    const float side = std::sqrt((float)PHYSICS_BODIES) * 1.1f;
+    PhysicsWorld start = physicsWorldInit();
+    start.gravity = glm::vec2(0.0f, -9.8f);
+    start.boundsMin = glm::vec2(0.0f);
+    start.boundsMax = glm::vec2(side);
+    std::uniform_real_distribution<float> position(0.5f, side - 0.5f);
+    for (int i = 0; i < PHYSICS_BODIES; i++) {
+        addPhysicsBody(start, glm::vec2(position(random), position(random)), 0.0f, mass.mass,
+            mass.inertia, 0.2f, 0.5f);
+    }
+
+    std::vector<CollisionBody> bodies(PHYSICS_BODIES);
+    std::vector<ContactPair> contacts;
+    std::vector<int> threadCounts = {1};
+    int cores = (int)std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 2; threads <= cores; threads *= 2)
+        threadCounts.push_back(threads);
+    if (threadCounts.back() != cores)
+        threadCounts.push_back(cores);
+
+    for (int threads : threadCounts) {
+        PhysicsWorld physics = start;
+        physics.threads = threads;
+        auto step = [&]() {
+            // collision bodies are body i + 1, body 0 is the static padding body
+            for (int i = 0; i < PHYSICS_BODIES; i++) {
+                glm::mat4 transform = glm::translate(glm::mat4(1.0f),
+                    glm::vec3(physics.bodies.x[i + 1], physics.bodies.y[i + 1], 0.0f));
+                bodies[i] = {shape, i, glm::rotate(transform, physics.bodies.angle[i + 1], glm::vec3(0.0f, 0.0f, 1.0f))};
+            }
+            detectCollisions(collision, bodies, contacts);
+            for (ContactPair& contact : contacts) {
+                contact.a++;
+                contact.b++;
+            }
+            physicsStep(physics, contacts, 1.0f / 60.0f);
+            benchSink = benchSink + physics.bodies.x[1];
+        };
+        BenchResult result = runBench("physics_20k_step_t" + std::to_string(threads), PHYSICS_BODIES, step);
+        results.push_back(result);
+        std::cout << "INFO: physics " << threads << " thread(s): " << contacts.size() << " contacts, " <<
+            physics.constraints.colorStart.size() - 1 << " colors, " <<
+            (long)(1e9 / 60.0 / result.nsPerOp) << " bodies at 60 Hz" << std::endl;
+    }
+}
+
+// animation case: ANIMATED_OBJECTS objects with a looping track for each of the four channels,
+// random curves per key and random start times, evaluated one 60 Hz frame per call
+static void benchAnimation(std::vector<BenchResult>& results, std::mt19937& random) {
+    Animator animator;
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f), start(0.0f, 2.0f);
+    std::uniform_int_distribution<int> curve(0, CURVE_COUNT - 1);
+    const AnimationChannel channels[4] = {CHANNEL_TRANSLATION, CHANNEL_ROTATION, CHANNEL_SCALE, CHANNEL_COLOR};
+    for (int object = 0; object < ANIMATED_OBJECTS; object++) {
+        for (AnimationChannel channel : channels) {
+            std::vector<Keyframe> keys;
+            for (int k = 0; k < 4; k++) {
+                keys.push_back({k * 0.5f, glm::vec4(value(random), value(random), value(random), 1.0f),
+                    glm::vec4(value(random)), (AnimationCurve)curve(random)});
+            }
+            addAnimationTrack(animator, object, channel, keys, start(random), true);
+        }
+    }
+
+    // every track has started by the first evaluated frame
+    float time = 2.0f;
+    int active = 0;
+    results.push_back(runBench("animate_100k_objects", ANIMATED_OBJECTS, [&]() {
+        time += 1.0f / 60.0f;
+        active = evaluateAnimations(animator, time);
+        benchSink = benchSink + animator.values[animator.updated.empty() ? 0 : animator.updated[0]].x;
+    }));
+    std::cout << "INFO: animation " << animator.tracks.size() << " tracks, " << active << " active" << std::endl;
+}
+
+// JSON output: one case per line, so the baseline reader below can stay trivial
+static bool writeJson(const char* path, const std::vector<BenchResult>& results) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+        return false;
+
+    file << "{\"benchmarks\":[\n";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        file << "{\"name\":\"" << results[i].name << "\",\"ns_per_op\":" << results[i].nsPerOp <<
+            ",\"ops_per_second\":" << results[i].opsPerSecond << ",\"cycles_per_op\":" <<
+            results[i].cyclesPerOp << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "]}\n";
+    return (bool)file;
+}
+
+// baseline reader: name -> ns/op from a file written by writeJson
+static std::map<std::string, double> readBaseline(const char* path) {
+    std::map<std::string, double> baseline;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::size_t name = line.find("\"name\":\"");
+        std::size_t ns = line.find("\"ns_per_op\":");
+        if (name == std::string::npos || ns == std::string::npos)
+            continue;
+        name += 8;
+        baseline[line.substr(name, line.find('"', name) - name)] = std::atof(line.c_str() + ns + 12);
+    }
+    return baseline;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = NULL;
+    const char* baselinePath = NULL;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--json") == 0)
+            jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--compare") == 0)
+            baselinePath = argv[++i];
+    }
+
+    // fixed seed: every run benchmarks the same data
+    std::mt19937 random(12345);
+    TransformInputs inputs = makeInputs(random);
+
+    std::vector<BenchResult> results;
+    benchTransforms(results, inputs);
+    benchMatrices(results, inputs);
+    benchPacking(results, random);
+    benchPicking(results, random);
+    benchSceneGraph(results, inputs);
+    benchEcs(results, inputs);
+    benchCollision(results, random);
+    benchPhysics(results, random);
+    benchAnimation(results, random);
+
+    std::map<std::string, double> baseline;
+    if (baselinePath) {
+        baseline = readBaseline(baselinePath);
+        if (baseline.empty())
+            std::cout << "ERROR: no benchmarks in baseline " << baselinePath << std::endl;
+    }
+
+    std::printf("%-24s %12s %14s %12s%s\n", "benchmark", "ns/op", "ops/s", "cycles/op",
+        baseline.empty() ? "" : "   vs baseline");
+    for (const BenchResult& result : results) {
+        std::printf("%-24s %12.3f %14.4g %12.2f", result.name.c_str(), result.nsPerOp,
+            result.opsPerSecond, result.cyclesPerOp);
+        auto previous = baseline.find(result.name);
+        if (previous != baseline.end() && previous->second > 0.0)
+            std::printf("   %+7.1f%%", (result.nsPerOp / previous->second - 1.0) * 100.0);
+        std::printf("\n");
+    }
+
+    if (jsonPath && !writeJson(jsonPath, results)) {
+        std::cout << "ERROR: could not write " << jsonPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -86,6 +86,13 @@ GLAPI int gladLoadGL(void);
 
 GLAPI int gladLoadGLLoader(GLADloadproc);
 
+/* minimal loader: resolve only the entry points listed in the application manifest (src/glad.c) */
+GLAPI int gladLoadGLLoaderMinimal(GLADloadproc);
+GLAPI int gladManifestSize(void);
+
+/* extension lookup: hashed, the extension list is read once on the first call */
+GLAPI int gladHasExtension(const char *ext);
+
 #include <KHR/khrplatform.h>
 typedef unsigned int GLenum;
 typedef unsigned char GLboolean;
@@ -0,0 +1,16 @@
+#version 330 core
+uniform bool edgeSmoothing;
+uniform vec3 tint;
+in vec3 fragmentColor;
+in vec3 edgeDistance;
+out vec4 finalColor;
+void main()
+{
+   // edge coverage: distance to the nearest outline edge in pixels, faded out over one pixel
+   float coverage = 1.0;
+   if (edgeSmoothing) {
+      vec3 pixels = edgeDistance / max(fwidth(edgeDistance), vec3(1e-6));
+      coverage = clamp(min(min(pixels.x, pixels.y), pixels.z), 0.0, 1.0);
+   }
+   finalColor = vec4 (fragmentColor * tint, coverage);
+}
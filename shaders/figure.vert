@@ -0,0 +1,15 @@
+#version 330 core
+uniform mat4 transform;
+uniform samplerBuffer palette;
+uniform int paletteOffset;
+layout (location = 0) in vec3 vertexPos;
+layout (location = 1) in float vertexPaletteIndex;
+layout (location = 2) in vec3 vertexEdgeDistance;
+out vec3 fragmentColor;
+out vec3 edgeDistance;
+void main()
+{
+   gl_Position = transform * vec4(vertexPos, 1.0f);
+   fragmentColor = texelFetch(palette, paletteOffset + int(vertexPaletteIndex)).rgb;
+   edgeDistance = vertexEdgeDistance;
+}
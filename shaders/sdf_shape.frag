@@ -0,0 +1,41 @@
+#version 330 core
+uniform bool edgeSmoothing;
+in vec2 localPos;
+flat in vec4 shapeParams;
+flat in vec4 shapeInner;
+flat in vec4 shapeOuter;
+out vec4 finalColor;
+
+// regular polygon distance: fold the point into one sector, then measure to that sector's edge
+float polygonDistance(vec2 p, float radius, float sides)
+{
+   if (sides < 3.0)
+      return length(p) - radius;
+   float halfAngle = 3.14159265 / sides;
+   float angle = mod(atan(p.y, p.x), 2.0 * halfAngle) - halfAngle;
+   p = length(p) * vec2(cos(angle), abs(sin(angle)));
+   p -= radius * vec2(cos(halfAngle), sin(halfAngle));
+   p.y += clamp(-p.y, 0.0, radius * sin(halfAngle));
+   return length(p) * sign(p.x);
+}
+
+vec3 hue(float turns)
+{
+   return clamp(abs(mod(turns * 6.0 + vec3(0.0, 4.0, 2.0), 6.0) - 3.0) - 1.0, 0.0, 1.0);
+}
+
+void main()
+{
+   float s = sin(shapeParams.w), c = cos(shapeParams.w);
+   vec2 p = mat2(c, -s, s, c) * localPos;
+   float d = polygonDistance(p, shapeParams.y - shapeParams.z, shapeParams.x) - shapeParams.z;
+
+   // edge coverage: the distance in pixels, faded out over one pixel around the edge
+   float coverage = edgeSmoothing ? clamp(0.5 - d / max(fwidth(d), 1e-6), 0.0, 1.0) : step(d, 0.0);
+   if (coverage <= 0.0)
+      discard;
+
+   vec3 outer = shapeOuter.a > 0.5 ? hue(atan(p.y, p.x) / 6.2831853) : shapeOuter.rgb;
+   vec3 color = mix(shapeInner.rgb, outer, clamp(length(p) / shapeParams.y, 0.0, 1.0));
+   finalColor = vec4(color, coverage);
+}
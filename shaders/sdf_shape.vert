@@ -0,0 +1,19 @@
+#version 330 core
+layout (location = 0) in vec2 quadCorner;
+layout (location = 1) in mat4 transform;
+layout (location = 5) in vec4 shape;
+layout (location = 6) in vec4 innerColor;
+layout (location = 7) in vec4 outerColor;
+out vec2 localPos;
+flat out vec4 shapeParams;
+flat out vec4 shapeInner;
+flat out vec4 shapeOuter;
+void main()
+{
+   // quad margin: a little room outside the radius for the smoothed edge
+   localPos = quadCorner * shape.y * 1.1;
+   gl_Position = transform * vec4(localPos, 0.0, 1.0);
+   shapeParams = shape;
+   shapeInner = innerColor;
+   shapeOuter = outerColor;
+}
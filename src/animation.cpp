@@ -0,0 +1,202 @@
+#include "animation.h"
+
+// the easing and spline functions are glm extensions (gtx), which glm wants confirmed
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/easing.hpp>
+#include <glm/gtx/spline.hpp>
+
+#include <cmath>
+
+int addAnimationTrack(Animator& animator, int target, AnimationChannel channel,
+        const std::vector<Keyframe>& keys, float start, bool loop) {
+    AnimationTrack track;
+    track.target = target;
+    track.channel = channel;
+    track.start = start;
+    track.loop = loop && keys.size() > 1;
+    track.active = !keys.empty();
+    track.firstKey = (int)animator.keyTimes.size();
+    track.keyCount = (int)keys.size();
+    track.cursor = 0;
+    for (const Keyframe& key : keys) {
+        animator.keyTimes.push_back(key.time);
+        animator.keyValues.push_back(key.value);
+        animator.keyTangents.push_back(key.tangent);
+        animator.keyCurves.push_back((unsigned char)key.curve);
+    }
+    animator.tracks.push_back(track);
+    animator.values.push_back(keys.empty() ? glm::vec4(0.0f) : keys[0].value);
+    return (int)animator.tracks.size() - 1;
+}
+
+void playAnimations(Animator& animator, float start) {
+    for (AnimationTrack& track : animator.tracks) {
+        track.start = start;
+        track.active = track.keyCount > 0;
+        track.cursor = 0;
+    }
+}
+
+void stopAnimations(Animator& animator) {
+    for (AnimationTrack& track : animator.tracks)
+        track.active = false;
+}
+
+// segment search: the key the local time is in, from the cursor on (time mostly moves forward)
+static int findSegment(const float* times, const AnimationTrack& track, float local) {
+    int key = track.cursor < track.keyCount && times[track.cursor] <= local ? track.cursor : 0;
+    while (key + 2 < track.keyCount && times[key + 1] <= local)
+        key++;
+    return key;
+}
+
+// neighbour key: the value offset keys away from key, wrapping for loops, clamped otherwise
+// the last key of a loop is the first one again (the period runs from the first to the last key),
+// so the loop wraps over keyCount - 1 keys; wrapping over all of them would make the duplicate a
+// neighbour of itself and put a kink into the spline at the seam
+static const glm::vec4& neighbourValue(const Animator& animator, const AnimationTrack& track, int key, int offset) {
+    int index = key + offset;
+    int period = track.keyCount - 1;
+    if (track.loop)
+        index = (index % period + period) % period;
+    else
+        index = index < 0 ? 0 : (index >= track.keyCount ? track.keyCount - 1 : index);
+    return animator.keyValues[track.firstKey + index];
+}
+
+// easing: the mix factor of one curve for a run of samples, the curve is fixed for the whole loop
+template <typename Easing>
+static void easeRun(const float* times, float* factors, int count, Easing easing) {
+    for (int i = 0; i < count; i++)
+        factors[i] = easing(times[i]);
+}
+
+int evaluateAnimations(Animator& animator, float time) {
+    int trackCount = (int)animator.tracks.size();
+    animator.updated.clear();
+    animator.segmentTrack.clear();
+    animator.segmentKey.clear();
+    animator.segmentTime.clear();
+
+    // segments: local time of every active track, counted per curve
+    int counts[CURVE_COUNT] = {};
+    for (int i = 0; i < trackCount; i++) {
+        AnimationTrack& track = animator.tracks[i];
+        if (!track.active || time < track.start)
+            continue;
+
+        const float* times = &animator.keyTimes[track.firstKey];
+        float first = times[0], last = times[track.keyCount - 1];
+        float local = time - track.start + first;
+        if (track.loop && last > first) {
+            // wrap into the first period (floor is much cheaper than fmod here)
+            local -= std::floor((local - first) / (last - first)) * (last - first);
+        } else if (track.keyCount == 1 || local >= last) {
+            // finished: hold the last key
+            animator.values[i] = animator.keyValues[track.firstKey + track.keyCount - 1];
+            animator.updated.push_back(i);
+            track.active = false;
+            continue;
+        }
+
+        int key = findSegment(times, track, local);
+        track.cursor = key;
+        float length = times[key + 1] - times[key];
+        animator.segmentTrack.push_back(i);
+        animator.segmentKey.push_back(track.firstKey + key);
+        animator.segmentTime.push_back(length > 0.0f ? glm::clamp((local - times[key]) / length, 0.0f, 1.0f) : 1.0f);
+        counts[animator.keyCurves[track.firstKey + key]]++;
+    }
+
+    // filing: samples sorted by curve, with the keys each curve needs
+    int active = (int)animator.segmentTrack.size();
+    animator.curveStart[0] = 0;
+    for (int c = 0; c < CURVE_COUNT; c++)
+        animator.curveStart[c + 1] = animator.curveStart[c] + counts[c];
+    animator.sampleTrack.resize(active);
+    animator.sampleTime.resize(active);
+    animator.sampleBefore.resize(active);
+    animator.sampleFrom.resize(active);
+    animator.sampleTo.resize(active);
+    animator.sampleAfter.resize(active);
+    animator.factors.resize(active);
+
+    int fill[CURVE_COUNT];
+    for (int c = 0; c < CURVE_COUNT; c++)
+        fill[c] = animator.curveStart[c];
+    for (int segment = 0; segment < active; segment++) {
+        int key = animator.segmentKey[segment];
+        int curve = animator.keyCurves[key];
+        int sample = fill[curve]++;
+        animator.sampleTrack[sample] = animator.segmentTrack[segment];
+        animator.sampleTime[sample] = animator.segmentTime[segment];
+        animator.sampleFrom[sample] = animator.keyValues[key];
+        animator.sampleTo[sample] = animator.keyValues[key + 1];
+        if (curve == CURVE_CATMULL_ROM) {
+            const AnimationTrack& track = animator.tracks[animator.segmentTrack[segment]];
+            animator.sampleBefore[sample] = neighbourValue(animator, track, key - track.firstKey, -1);
+            animator.sampleAfter[sample] = neighbourValue(animator, track, key - track.firstKey, 2);
+        } else if (curve == CURVE_HERMITE) {
+            // the tangents are per second, the spline runs over the segment in 0 - 1
+            float length = animator.keyTimes[key + 1] - animator.keyTimes[key];
+            animator.sampleBefore[sample] = animator.keyTangents[key] * length;
+            animator.sampleAfter[sample] = animator.keyTangents[key + 1] * length;
+        }
+    }
+
+    // evaluation: one run per curve
+    for (int c = 0; c < CURVE_COUNT; c++) {
+        int first = animator.curveStart[c], count = animator.curveStart[c + 1] - first;
+        if (count == 0)
+            continue;
+        const float* times = &animator.sampleTime[first];
+        float* factors = &animator.factors[first];
+        const int* tracks = &animator.sampleTrack[first];
+        const glm::vec4* before = &animator.sampleBefore[first];
+        const glm::vec4* from = &animator.sampleFrom[first];
+        const glm::vec4* to = &animator.sampleTo[first];
+        const glm::vec4* after = &animator.sampleAfter[first];
+        glm::vec4* values = animator.values.data();
+
+        if (c == CURVE_CATMULL_ROM) {
+            for (int i = 0; i < count; i++)
+                values[tracks[i]] = glm::catmullRom(before[i], from[i], to[i], after[i], times[i]);
+            continue;
+        }
+        if (c == CURVE_HERMITE) {
+            for (int i = 0; i < count; i++)
+                values[tracks[i]] = glm::hermite(from[i], before[i], to[i], after[i], times[i]);
+            continue;
+        }
+
+        switch (c) {
+            case CURVE_LINEAR:
+                easeRun(times, factors, count, [](float t) { return glm::linearInterpolation(t); });
+                break;
+            case CURVE_QUADRATIC_IN_OUT:
+                easeRun(times, factors, count, [](float t) { return glm::quadraticEaseInOut(t); });
+                break;
+            case CURVE_CUBIC_OUT:
+                easeRun(times, factors, count, [](float t) { return glm::cubicEaseOut(t); });
+                break;
+            case CURVE_SINE_IN_OUT:
+                easeRun(times, factors, count, [](float t) { return glm::sineEaseInOut(t); });
+                break;
+            case CURVE_BACK_OUT:
+                easeRun(times, factors, count, [](float t) { return glm::backEaseOut(t); });
+                break;
+            case CURVE_ELASTIC_OUT:
+                easeRun(times, factors, count, [](float t) { return glm::elasticEaseOut(t); });
+                break;
+            case CURVE_BOUNCE_OUT:
+                easeRun(times, factors, count, [](float t) { return glm::bounceEaseOut(t); });
+                break;
+        }
+        for (int i = 0; i < count; i++)
+            values[tracks[i]] = from[i] + (to[i] - from[i]) * factors[i];
+    }
+
+    for (int i = 0; i < active; i++)
+        animator.updated.push_back(animator.sampleTrack[i]);
+    return active;
+}
@@ -0,0 +1,99 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// interpolation between two keyframes: the easing curves of glm/gtx/easing.hpp mix the two keys,
+// the splines of glm/gtx/spline.hpp also use the keys around them (Catmull-Rom) or the tangents
+// stored in the keys (Hermite)
+enum AnimationCurve {
+    CURVE_LINEAR,
+    CURVE_QUADRATIC_IN_OUT,
+    CURVE_CUBIC_OUT,
+    CURVE_SINE_IN_OUT,
+    CURVE_BACK_OUT,
+    CURVE_ELASTIC_OUT,
+    CURVE_BOUNCE_OUT,
+    CURVE_CATMULL_ROM,
+    CURVE_HERMITE,
+    CURVE_COUNT
+};
+
+// animated property: translation uses x and y of a value, rotation and scale x, color x, y and z
+enum AnimationChannel {
+    CHANNEL_TRANSLATION,
+    CHANNEL_ROTATION,
+    CHANNEL_SCALE,
+    CHANNEL_COLOR
+};
+
+// structure to store one keyframe: the value at a time (seconds from the track start)
+// curve and tangent shape the segment from this key to the next one
+struct Keyframe {
+    float time;
+    glm::vec4 value;
+    glm::vec4 tangent; // Hermite only: slope per second when leaving and arriving at the key
+    AnimationCurve curve;
+};
+
+// structure to store one track: the keys of one channel of one target, in time order
+// target is whatever the caller animates (an index into its own table)
+struct AnimationTrack {
+    int target;
+    AnimationChannel channel;
+    float start; // animation time of the first key
+    bool loop;   // restart at the first key after the last one, which has to repeat the first
+    bool active; // started and not finished
+    int firstKey;
+    int keyCount;
+    int cursor; // key at the start of the current segment
+};
+
+// structure to store every track and the scratch state of an evaluation
+// the keys of all tracks are stored by field (each track a contiguous range), so the segment
+// search only reads key times and only the two keys of the current segment load their values
+// an evaluation locates the segment of every active track and files it by curve (counting sort),
+// then evaluates each curve over its whole run of samples: the curve is chosen once per run, not
+// per track, and the runs are plain loops over SoA arrays
+struct Animator {
+    std::vector<float> keyTimes;
+    std::vector<glm::vec4> keyValues;
+    std::vector<glm::vec4> keyTangents;
+    std::vector<unsigned char> keyCurves;
+    std::vector<AnimationTrack> tracks;
+
+    std::vector<glm::vec4> values; // value of every track after the last evaluation
+    std::vector<int> updated;      // tracks whose value was written by the last evaluation
+
+    // samples sorted by curve, curveStart[c] is the first sample of curve c
+    int curveStart[CURVE_COUNT + 1];
+    std::vector<int> sampleTrack;
+    std::vector<float> sampleTime; // position inside the segment, 0 - 1
+    std::vector<glm::vec4> sampleBefore; // Catmull-Rom: key before the segment, Hermite: first tangent
+    std::vector<glm::vec4> sampleFrom;
+    std::vector<glm::vec4> sampleTo;
+    std::vector<glm::vec4> sampleAfter;  // Catmull-Rom: key after the segment, Hermite: second tangent
+    std::vector<float> factors;
+
+    // segments of this evaluation, in track order: the track, its segment key and the position
+    std::vector<int> segmentTrack;
+    std::vector<int> segmentKey;
+    std::vector<float> segmentTime;
+};
+
+// track creation: the keys have to be in time order, returns the track index
+int addAnimationTrack(Animator& animator, int target, AnimationChannel channel,
+    const std::vector<Keyframe>& keys, float start, bool loop);
+
+// playback: restart every track at the given animation time (or stop them all)
+void playAnimations(Animator& animator, float start);
+void stopAnimations(Animator& animator);
+
+// evaluation: the value of every active track at the animation time, see values and updated
+// a track that ends is written once more with its last key and becomes inactive
+// returns the number of tracks still active
+int evaluateAnimations(Animator& animator, float time);
+
+#endif
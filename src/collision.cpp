@@ -0,0 +1,549 @@
+#include "collision.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+static float cross(glm::vec2 a, glm::vec2 b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+static float signedArea(const std::vector<glm::vec2>& polygon) {
+    float area = 0.0f;
+    for (unsigned int i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+        area += cross(polygon[j], polygon[i]);
+    return area * 0.5f;
+}
+
+// convexity: every turn of a counter-clockwise polygon goes left (collinear points are fine)
+static bool isConvex(const std::vector<glm::vec2>& polygon) {
+    int count = (int)polygon.size();
+    for (int i = 0; i < count; i++) {
+        glm::vec2 a = polygon[i], b = polygon[(i + 1) % count], c = polygon[(i + 2) % count];
+        if (cross(b - a, c - b) < -1e-7f)
+            return false;
+    }
+    return true;
+}
+
+static bool pointInTriangle(glm::vec2 p, glm::vec2 a, glm::vec2 b, glm::vec2 c) {
+    return cross(b - a, p - a) >= 0.0f && cross(c - b, p - b) >= 0.0f && cross(a - c, p - c) >= 0.0f;
+}
+
+// ear clipping: cut off convex corners that contain no other point until a triangle is left
+static std::vector<std::vector<glm::vec2>> triangulate(std::vector<glm::vec2> polygon) {
+    std::vector<std::vector<glm::vec2>> triangles;
+    while (polygon.size() > 3) {
+        int count = (int)polygon.size();
+        bool clipped = false;
+        for (int i = 0; i < count && !clipped; i++) {
+            glm::vec2 a = polygon[(i + count - 1) % count], b = polygon[i], c = polygon[(i + 1) % count];
+            if (cross(b - a, c - b) <= 0.0f)
+                continue;
+
+            bool ear = true;
+            for (int j = 0; j < count && ear; j++) {
+                if (j != i && j != (i + 1) % count && j != (i + count - 1) % count)
+                    ear = !pointInTriangle(polygon[j], a, b, c);
+            }
+            if (ear) {
+                triangles.push_back({a, b, c});
+                polygon.erase(polygon.begin() + i);
+                clipped = true;
+            }
+        }
+        if (!clipped)
+            break; // not a simple polygon, keep what is left as it is
+    }
+    triangles.push_back(polygon);
+    return triangles;
+}
+
+// piece merge (Hertel-Mehlhorn): join two pieces across a shared edge while the result stays convex
+static bool mergePieces(const std::vector<glm::vec2>& a, const std::vector<glm::vec2>& b,
+        std::vector<glm::vec2>& merged) {
+    int countA = (int)a.size(), countB = (int)b.size();
+    for (int i = 0; i < countA; i++) {
+        glm::vec2 p = a[i], q = a[(i + 1) % countA];
+        for (int j = 0; j < countB; j++) {
+            if (b[j] != q || b[(j + 1) % countB] != p)
+                continue;
+
+            // shared edge p -> q in a is q -> p in b: walk a up to p, then b from p round to q
+            merged.clear();
+            for (int k = 0; k < countA; k++)
+                merged.push_back(a[(i + 1 + k) % countA]);
+            for (int k = 2; k < countB; k++)
+                merged.push_back(b[(j + k) % countB]);
+            return isConvex(merged);
+        }
+    }
+    return false;
+}
+
+std::vector<std::vector<glm::vec2>> decomposeConvex(const std::vector<glm::vec2>& outline) {
+    std::vector<glm::vec2> polygon = outline;
+    if (signedArea(polygon) < 0.0f)
+        std::reverse(polygon.begin(), polygon.end());
+    if (polygon.size() <= 3 || isConvex(polygon))
+        return {polygon};
+
+    std::vector<std::vector<glm::vec2>> pieces = triangulate(polygon);
+    std::vector<glm::vec2> merged;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (unsigned int i = 0; i < pieces.size() && !changed; i++) {
+            for (unsigned int j = i + 1; j < pieces.size() && !changed; j++) {
+                if (mergePieces(pieces[i], pieces[j], merged)) {
+                    pieces[i] = merged;
+                    pieces.erase(pieces.begin() + j);
+                    changed = true;
+                }
+            }
+        }
+    }
+    return pieces;
+}
+
+// edge normals: outward unit normal of every edge of a counter-clockwise convex polygon
+static void edgeNormals(const glm::vec2* points, int count, glm::vec2* normals) {
+    for (int i = 0; i < count; i++) {
+        glm::vec2 edge = points[(i + 1) % count] - points[i];
+        float length = glm::length(edge);
+        normals[i] = length > 1e-12f ? glm::vec2(edge.y, -edge.x) / length : glm::vec2(0.0f);
+    }
+}
+
+int addCollisionShape(CollisionWorld& world, const std::vector<glm::vec2>& outline) {
+    CollisionShape shape;
+    for (const std::vector<glm::vec2>& piece : decomposeConvex(outline)) {
+        shape.pieceStart.push_back((int)shape.points.size());
+        shape.points.insert(shape.points.end(), piece.begin(), piece.end());
+    }
+    shape.pieceStart.push_back((int)shape.points.size());
+
+    shape.radius = 0.0f;
+    for (const glm::vec2& point : shape.points)
+        shape.radius = std::max(shape.radius, glm::length(point));
+
+    shape.normals.resize(shape.points.size());
+    for (unsigned int i = 0; i + 1 < shape.pieceStart.size(); i++) {
+        int start = shape.pieceStart[i];
+        edgeNormals(&shape.points[start], shape.pieceStart[i + 1] - start, &shape.normals[start]);
+    }
+    world.shapes.push_back(shape);
+    return (int)world.shapes.size() - 1;
+}
+
+// face separation: the largest distance of b in front of one of the faces of a
+// a convex polygon lies entirely behind each of its own faces, so only b has to be projected
+// (half the work of projecting both polygons on every axis); positive means separated
+static float maxSeparation(const glm::vec2* a, const glm::vec2* normalsA, int countA,
+        const glm::vec2* b, int countB, int& face) {
+    float best = -FLT_MAX;
+    for (int i = 0; i < countA; i++) {
+        float separation = FLT_MAX;
+        for (int j = 0; j < countB; j++)
+            separation = std::min(separation, glm::dot(normalsA[i], b[j] - a[i]));
+        if (separation > best) {
+            best = separation;
+            face = i;
+            if (best > 0.0f)
+                break;
+        }
+    }
+    return best;
+}
+
+// deepest corner: the point of a polygon farthest behind a face, along the face normal
+static glm::vec2 deepestPoint(const glm::vec2* points, int count, glm::vec2 normal) {
+    int deepest = 0;
+    for (int i = 1; i < count; i++) {
+        if (glm::dot(normal, points[i]) < glm::dot(normal, points[deepest]))
+            deepest = i;
+    }
+    return points[deepest];
+}
+
+// piece overlap: the axis of least penetration over the faces of both pieces
+static bool pieceOverlap(const glm::vec2* a, const glm::vec2* normalsA, int countA,
+        const glm::vec2* b, const glm::vec2* normalsB, int countB, glm::vec2& normal, float& depth,
+        glm::vec2& point) {
+    int faceA = 0, faceB = 0;
+    float separationA = maxSeparation(a, normalsA, countA, b, countB, faceA);
+    if (separationA > 0.0f)
+        return false;
+    float separationB = maxSeparation(b, normalsB, countB, a, countA, faceB);
+    if (separationB > 0.0f)
+        return false;
+
+    // a face of a points away from a, towards b; a face of b has to be turned around
+    // the deepest point is the corner of the other piece farthest behind that face
+    if (separationA >= separationB) {
+        normal = normalsA[faceA];
+        depth = -separationA;
+        point = deepestPoint(b, countB, normalsA[faceA]);
+    } else {
+        normal = -normalsB[faceB];
+        depth = -separationB;
+        point = deepestPoint(a, countA, normalsB[faceB]);
+    }
+    return true;
+}
+
+bool convexOverlap(const glm::vec2* a, int countA, const glm::vec2* b, int countB,
+        glm::vec2& normal, float& depth, glm::vec2& point) {
+    std::vector<glm::vec2> normalsA(countA), normalsB(countB);
+    edgeNormals(a, countA, normalsA.data());
+    edgeNormals(b, countB, normalsB.data());
+    return pieceOverlap(a, normalsA.data(), countA, b, normalsB.data(), countB, normal, depth, point);
+}
+
+static uint32_t cellBucket(glm::ivec2 cell, uint32_t mask) {
+    return ((uint32_t)cell.x * 73856093u ^ (uint32_t)cell.y * 19349663u) & mask;
+}
+
+// hash grid: bound every body by a circle and file it under the bucket of its cell
+// counting sort keeps the filing to two passes over the bodies
+static void buildHashGrid(CollisionWorld& world, const std::vector<CollisionBody>& bodies) {
+    int count = (int)bodies.size();
+    world.bodyEntries.resize(count);
+    float cellSize = 1e-6f;
+    for (int i = 0; i < count; i++) {
+        const glm::mat4& m = bodies[i].transform;
+        float scale = std::max(glm::length(glm::vec2(m[0])), glm::length(glm::vec2(m[1])));
+        GridEntry& entry = world.bodyEntries[i];
+        entry.center = glm::vec2(m[3][0], m[3][1]);
+        entry.radius = world.shapes[bodies[i].shape].radius * scale;
+        entry.body = i;
+        entry.group = bodies[i].group;
+        cellSize = std::max(cellSize, 2.0f * entry.radius);
+    }
+
+    uint32_t buckets = 1;
+    while (buckets < (uint32_t)count * 2)
+        buckets <<= 1;
+
+    world.bucketStart.assign(buckets + 1, 0);
+    std::vector<uint32_t> entryBuckets(count);
+    for (int i = 0; i < count; i++) {
+        GridEntry& entry = world.bodyEntries[i];
+        entry.cell = glm::ivec2(glm::floor((entry.center - entry.radius) / cellSize));
+        entryBuckets[i] = cellBucket(entry.cell, buckets - 1);
+        world.bucketStart[entryBuckets[i] + 1]++;
+    }
+    for (uint32_t i = 0; i < buckets; i++)
+        world.bucketStart[i + 1] += world.bucketStart[i];
+
+    world.gridEntries.resize(count);
+    std::vector<uint32_t> fill(world.bucketStart.begin(), world.bucketStart.end() - 1);
+    for (int i = 0; i < count; i++)
+        world.gridEntries[fill[entryBuckets[i]]++] = world.bodyEntries[i];
+
+    world.bodyEntry.resize(count);
+    for (int i = 0; i < count; i++)
+        world.bodyEntry[world.gridEntries[i].body] = i;
+    world.cellSize = cellSize;
+}
+
+// world transform: every point and edge normal of every entry, in entry order
+static void transformEntries(CollisionWorld& world, const std::vector<CollisionBody>& bodies) {
+    int count = (int)world.gridEntries.size();
+    world.entryPoints.resize(count + 1);
+
+    int total = 0;
+    for (int i = 0; i < count; i++) {
+        world.entryPoints[i] = total;
+        total += (int)world.shapes[bodies[world.gridEntries[i].body].shape].points.size();
+    }
+    world.entryPoints[count] = total;
+    world.worldPoints.resize(total);
+    world.worldNormals.resize(total);
+
+    for (int i = 0; i < count; i++) {
+        const CollisionBody& body = bodies[world.gridEntries[i].body];
+        const CollisionShape& shape = world.shapes[body.shape];
+        const glm::mat4& m = body.transform;
+        glm::vec2* out = &world.worldPoints[world.entryPoints[i]];
+        glm::vec2* outNormals = &world.worldNormals[world.entryPoints[i]];
+
+        // normals go through the inverse transpose of the 2x2 part, which for a rotation with
+        // uniform scale is the matrix itself up to the length, restored by the normalisation
+        for (unsigned int p = 0; p < shape.points.size(); p++) {
+            glm::vec2 local = shape.points[p], normal = shape.normals[p];
+            out[p] = glm::vec2(m[0][0] * local.x + m[1][0] * local.y + m[3][0],
+                m[0][1] * local.x + m[1][1] * local.y + m[3][1]);
+            outNormals[p] = glm::normalize(glm::vec2(m[0][0] * normal.x + m[1][0] * normal.y,
+                m[0][1] * normal.x + m[1][1] * normal.y));
+        }
+    }
+}
+
+// narrow phase: the deepest overlap over all piece pairs of two entries
+static bool entryOverlap(const CollisionWorld& world, const std::vector<CollisionBody>& bodies,
+        int a, int b, ContactPair& contact) {
+    const CollisionShape& shapeA = world.shapes[bodies[world.gridEntries[a].body].shape];
+    const CollisionShape& shapeB = world.shapes[bodies[world.gridEntries[b].body].shape];
+    const glm::vec2* pointsA = &world.worldPoints[world.entryPoints[a]];
+    const glm::vec2* pointsB = &world.worldPoints[world.entryPoints[b]];
+    const glm::vec2* normalsA = &world.worldNormals[world.entryPoints[a]];
+    const glm::vec2* normalsB = &world.worldNormals[world.entryPoints[b]];
+
+    bool hit = false;
+    contact.depth = 0.0f;
+    for (unsigned int i = 0; i + 1 < shapeA.pieceStart.size(); i++) {
+        int startA = shapeA.pieceStart[i], countA = shapeA.pieceStart[i + 1] - startA;
+        for (unsigned int j = 0; j + 1 < shapeB.pieceStart.size(); j++) {
+            int startB = shapeB.pieceStart[j], countB = shapeB.pieceStart[j + 1] - startB;
+            glm::vec2 normal, point;
+            float depth;
+            if (pieceOverlap(pointsA + startA, normalsA + startA, countA,
+                    pointsB + startB, normalsB + startB, countB, normal, depth, point) &&
+                    depth > contact.depth) {
+                contact.normal = normal;
+                contact.depth = depth;
+                contact.point = point;
+                hit = true;
+            }
+        }
+    }
+    return hit;
+}
+
+void detectCollisions(CollisionWorld& world, const std::vector<CollisionBody>& bodies,
+        std::vector<ContactPair>& contacts) {
+    contacts.clear();
+    world.candidatePairs = 0;
+    buildHashGrid(world, bodies);
+    transformEntries(world, bodies);
+    uint32_t bucketMask = (uint32_t)world.bucketStart.size() - 2;
+
+    // neighbourhood: the entry's own cell and four of its eight neighbours, the other four are
+    // covered when the neighbour's entries look back; within the own cell only later entries
+    const glm::ivec2 NEIGHBOURS[5] = {{0, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+    const std::vector<GridEntry>& entries = world.gridEntries;
+    for (unsigned int i = 0; i < entries.size(); i++) {
+        const GridEntry& entryA = entries[i];
+        for (const glm::ivec2& step : NEIGHBOURS) {
+            glm::ivec2 cell = entryA.cell + step;
+            uint32_t bucket = cellBucket(cell, bucketMask);
+            uint32_t first = step == glm::ivec2(0, 0) ? i + 1 : world.bucketStart[bucket];
+            for (uint32_t k = first; k < world.bucketStart[bucket + 1]; k++) {
+                const GridEntry& entryB = entries[k];
+                // other cells can share the bucket
+                if (entryB.cell != cell || entryA.group == entryB.group)
+                    continue;
+
+                glm::vec2 offset = entryB.center - entryA.center;
+                float reach = entryA.radius + entryB.radius;
+                if (glm::dot(offset, offset) > reach * reach)
+                    continue;
+
+                world.candidatePairs++;
+                ContactPair contact;
+                if (!entryOverlap(world, bodies, i, k, contact))
+                    continue;
+
+                // contacts name bodies, with the normal from the lower body to the higher one
+                contact.a = entryA.body;
+                contact.b = entryB.body;
+                if (contact.a > contact.b) {
+                    std::swap(contact.a, contact.b);
+                    contact.normal = -contact.normal;
+                }
+                contacts.push_back(contact);
+            }
+        }
+    }
+
+    std::sort(contacts.begin(), contacts.end(), [](const ContactPair& x, const ContactPair& y) {
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+}
+
+// projection: the interval a convex polygon covers along an axis
+static void project(const glm::vec2* points, int count, glm::vec2 axis, float& low, float& high) {
+    low = FLT_MAX;
+    high = -FLT_MAX;
+    for (int i = 0; i < count; i++) {
+        float distance = glm::dot(axis, points[i]);
+        low = std::min(low, distance);
+        high = std::max(high, distance);
+    }
+}
+
+// piece sweep: first time in [0, 1] at which a, translated by motion, touches b (swept SAT)
+// on every face axis the projections overlap during one time interval, the pieces touch once all
+// intervals have started; the axis that starts last is the contact normal
+static bool pieceSweep(const glm::vec2* a, const glm::vec2* normalsA, int countA,
+        const glm::vec2* b, const glm::vec2* normalsB, int countB, glm::vec2 motion,
+        float& time, glm::vec2& normal) {
+    // allowed overlap at the start: a sweep that stopped at the contact ends up touching within
+    // rounding, the next sweep into the same face has to stop again instead of passing through
+    const float SLOP = 1e-5f;
+    float enter = -FLT_MAX, exit = FLT_MAX, enterGap = 0.0f, exitGap = FLT_MAX;
+    for (int k = 0; k < countA + countB; k++) {
+        glm::vec2 axis = k < countA ? normalsA[k] : normalsB[k - countA];
+        float lowA, highA, lowB, highB;
+        project(a, countA, axis, lowA, highA);
+        project(b, countB, axis, lowB, highB);
+
+        float speed = glm::dot(axis, motion);
+        if (speed == 0.0f) {
+            if (highA < lowB || lowA > highB)
+                return false;
+            continue;
+        }
+
+        // gap: the distance a has to travel along the axis before the intervals meet
+        float gap = speed > 0.0f ? lowB - highA : lowA - highB;
+        // pass: the distance until a has moved past b along the axis
+        float pass = speed > 0.0f ? highB - lowA : highA - lowB;
+        float first = gap / std::abs(speed), last = pass / std::abs(speed);
+        if (first > enter) {
+            enter = first;
+            enterGap = gap;
+            normal = speed > 0.0f ? axis : -axis;
+        }
+        if (last < exit) {
+            exit = last;
+            exitGap = pass;
+        }
+        if (enter >= exit || enter > 1.0f)
+            return false;
+    }
+
+    // already overlapping, or touching and moving apart: not an impact of this sweep
+    if ((enter < 0.0f && enterGap < -SLOP) || exitGap <= SLOP)
+        return false;
+    time = std::max(enter, 0.0f);
+    return true;
+}
+
+// entry sweep: the earliest impact over all piece pairs of two entries
+static bool entrySweep(const CollisionWorld& world, const std::vector<CollisionBody>& bodies,
+        int a, int b, glm::vec2 motion, float& time, glm::vec2& normal) {
+    const CollisionShape& shapeA = world.shapes[bodies[world.gridEntries[a].body].shape];
+    const CollisionShape& shapeB = world.shapes[bodies[world.gridEntries[b].body].shape];
+    const glm::vec2* pointsA = &world.worldPoints[world.entryPoints[a]];
+    const glm::vec2* pointsB = &world.worldPoints[world.entryPoints[b]];
+    const glm::vec2* normalsA = &world.worldNormals[world.entryPoints[a]];
+    const glm::vec2* normalsB = &world.worldNormals[world.entryPoints[b]];
+
+    bool hit = false;
+    for (unsigned int i = 0; i + 1 < shapeA.pieceStart.size(); i++) {
+        int startA = shapeA.pieceStart[i], countA = shapeA.pieceStart[i + 1] - startA;
+        for (unsigned int j = 0; j + 1 < shapeB.pieceStart.size(); j++) {
+            int startB = shapeB.pieceStart[j], countB = shapeB.pieceStart[j + 1] - startB;
+            float pieceTime;
+            glm::vec2 pieceNormal;
+            if (pieceSweep(pointsA + startA, normalsA + startA, countA, pointsB + startB,
+                    normalsB + startB, countB, motion, pieceTime, pieceNormal) &&
+                    (!hit || pieceTime < time)) {
+                time = pieceTime;
+                normal = pieceNormal;
+                hit = true;
+            }
+        }
+    }
+    return hit;
+}
+
+// swept bounds: can the circle of a, moving by motion, reach the circle of b?
+static bool sweptCirclesMeet(const GridEntry& a, const GridEntry& b, glm::vec2 motion) {
+    glm::vec2 offset = b.center - a.center;
+    float length = glm::dot(motion, motion);
+    float along = length > 0.0f ? glm::clamp(glm::dot(offset, motion) / length, 0.0f, 1.0f) : 0.0f;
+    glm::vec2 closest = offset - motion * along;
+    float reach = a.radius + b.radius;
+    return glm::dot(closest, closest) <= reach * reach;
+}
+
+// hit record: keep the earliest impact of a sweep
+static void recordHit(SweepHit& hit, float time, int body, int other, glm::vec2 normal) {
+    if (hit.body < 0 || time < hit.time)
+        hit = {time, body, other, normal};
+}
+
+void sweepCollisions(CollisionWorld& world, const std::vector<CollisionBody>& bodies,
+        const std::vector<GroupSweep>& sweeps, std::vector<SweepHit>& hits) {
+    hits.assign(sweeps.size(), {1.0f, -1, -1, glm::vec2(0.0f)});
+    world.candidatePairs = 0;
+    if (sweeps.empty())
+        return;
+    buildHashGrid(world, bodies);
+    transformEntries(world, bodies);
+    uint32_t bucketMask = (uint32_t)world.bucketStart.size() - 2;
+
+    std::vector<int> movers;
+    world.bodySweeps.assign(bodies.size(), -1);
+    for (unsigned int i = 0; i < bodies.size(); i++) {
+        for (unsigned int s = 0; s < sweeps.size(); s++) {
+            if (bodies[i].group == sweeps[s].group && sweeps[s].translation != glm::vec2(0.0f)) {
+                world.bodySweeps[i] = (int)s;
+                movers.push_back(world.bodyEntry[i]);
+                break;
+            }
+        }
+    }
+
+    const std::vector<GridEntry>& entries = world.gridEntries;
+    for (unsigned int m = 0; m < movers.size(); m++) {
+        int a = movers[m];
+        const GridEntry& entryA = entries[a];
+        int sweepA = world.bodySweeps[entryA.body];
+        glm::vec2 motion = sweeps[sweepA].translation;
+
+        // bodies in place: the cells under the swept bounds, plus one cell to the left and
+        // below, since bodies are filed under the cell of their minimum corner
+        // a sweep across more cells than there are bodies visits every body instead
+        glm::vec2 low = glm::min(entryA.center, entryA.center + motion) - entryA.radius;
+        glm::vec2 high = glm::max(entryA.center, entryA.center + motion) + entryA.radius;
+        glm::ivec2 firstCell = glm::ivec2(glm::floor(low / world.cellSize)) - 1;
+        glm::ivec2 lastCell = glm::ivec2(glm::floor(high / world.cellSize));
+        double cells = (double)(lastCell.x - firstCell.x + 1) * (lastCell.y - firstCell.y + 1);
+        auto sweepAgainst = [&](int b) {
+            const GridEntry& entryB = entries[b];
+            if (entryA.group == entryB.group || world.bodySweeps[entryB.body] >= 0 ||
+                    !sweptCirclesMeet(entryA, entryB, motion))
+                return;
+            world.candidatePairs++;
+            float time;
+            glm::vec2 normal;
+            if (entrySweep(world, bodies, a, b, motion, time, normal))
+                recordHit(hits[sweepA], time, entryA.body, entryB.body, normal);
+        };
+        if (cells > (double)entries.size()) {
+            for (unsigned int b = 0; b < entries.size(); b++)
+                sweepAgainst((int)b);
+        } else {
+            for (int y = firstCell.y; y <= lastCell.y; y++) {
+                for (int x = firstCell.x; x <= lastCell.x; x++) {
+                    uint32_t bucket = cellBucket(glm::ivec2(x, y), bucketMask);
+                    for (uint32_t b = world.bucketStart[bucket]; b < world.bucketStart[bucket + 1]; b++) {
+                        // other cells can share the bucket
+                        if (entries[b].cell == glm::ivec2(x, y))
+                            sweepAgainst((int)b);
+                    }
+                }
+            }
+        }
+
+        // moving bodies: a few, swept against each other with the relative motion
+        for (unsigned int n = m + 1; n < movers.size(); n++) {
+            int b = movers[n];
+            const GridEntry& entryB = entries[b];
+            int sweepB = world.bodySweeps[entryB.body];
+            glm::vec2 relative = motion - sweeps[sweepB].translation;
+            if (entryA.group == entryB.group || !sweptCirclesMeet(entryA, entryB, relative))
+                continue;
+            world.candidatePairs++;
+            float time;
+            glm::vec2 normal;
+            if (entrySweep(world, bodies, a, b, relative, time, normal)) {
+                recordHit(hits[sweepA], time, entryA.body, entryB.body, normal);
+                recordHit(hits[sweepB], time, entryB.body, entryA.body, -normal);
+            }
+        }
+    }
+}
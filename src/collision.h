@@ -0,0 +1,114 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// structure to store a collision shape as convex pieces in object space
+// piece i uses points[pieceStart[i]] up to points[pieceStart[i + 1]], counter-clockwise
+// normals[k] is the outward unit normal of the edge from point k to the next point of its piece
+// radius is the distance of the farthest point from the origin
+struct CollisionShape {
+    std::vector<glm::vec2> points;
+    std::vector<glm::vec2> normals;
+    std::vector<int> pieceStart;
+    float radius;
+};
+
+// structure to store one body for a detection pass: its shape, its world transform and its group
+// bodies of the same group (parts of one object) are never reported against each other
+struct CollisionBody {
+    int shape;
+    int group;
+    glm::mat4 transform;
+};
+
+// structure to store one contact: normal points from a to b, depth is the overlap along it
+// point is the deepest point of the overlap, a corner of one body inside the other
+struct ContactPair {
+    int a;
+    int b;
+    glm::vec2 normal;
+    float depth;
+    glm::vec2 point;
+};
+
+// structure to store the motion of one group over a step: every body of the group is translated
+struct GroupSweep {
+    int group;
+    glm::vec2 translation;
+};
+
+// structure to store the first impact of a sweep: the fraction of the translation travelled
+// before body touches other, and the contact normal pointing from body to other
+// a sweep without impact has time 1 and body/other -1
+struct SweepHit {
+    float time;
+    int body;
+    int other;
+    glm::vec2 normal;
+};
+
+// structure to store one body filed in the broad phase grid: its bounding circle (around the
+// body origin, needs no transformed points), its cell and where it came from
+struct GridEntry {
+    glm::vec2 center;
+    float radius;
+    glm::ivec2 cell;
+    int body;
+    int group;
+};
+
+// structure to store the shapes and the scratch state reused between passes
+// the broad phase is a spatial hash: a grid with cells as large as the largest body, every body
+// is filed under the cell of its minimum corner, so overlapping bodies are at most one cell apart
+// entries and world points are stored in bucket order, so the pair tests and the narrow phase
+// read neighbouring bodies from neighbouring memory
+struct CollisionWorld {
+    std::vector<CollisionShape> shapes;
+
+    // hash grid: bodies sorted by bucket (counting sort), bucketStart[i] is the first of bucket i
+    std::vector<GridEntry> bodyEntries; // in body order, before sorting
+    std::vector<uint32_t> bucketStart;
+    std::vector<GridEntry> gridEntries;
+    std::vector<int> bodyEntry; // entry of every body
+    float cellSize;
+
+    std::vector<glm::vec2> worldPoints;  // every point of every entry, in world space
+    std::vector<glm::vec2> worldNormals; // the edge normals of those points, in world space
+    std::vector<int> entryPoints;        // first world point of every entry
+
+    std::vector<int> bodySweeps; // sweep of every body, -1 for bodies that don't move
+
+    uint64_t candidatePairs; // pairs the broad phase handed to the narrow phase, last pass
+};
+
+// convex decomposition: split a simple polygon (either winding) into convex counter-clockwise
+// pieces; a convex outline comes back as a single piece
+std::vector<std::vector<glm::vec2>> decomposeConvex(const std::vector<glm::vec2>& outline);
+
+// shape creation: decompose the outline and store it, returns the shape index
+int addCollisionShape(CollisionWorld& world, const std::vector<glm::vec2>& outline);
+
+// overlap test of two convex polygons (separating axis theorem)
+// on overlap, normal and depth hold the axis of least penetration, pointing from a to b, and
+// point the deepest corner
+bool convexOverlap(const glm::vec2* a, int countA, const glm::vec2* b, int countB,
+    glm::vec2& normal, float& depth, glm::vec2& point);
+
+// detection pass: spatial hash over the world bounds, then SAT between the convex pieces of
+// every candidate pair; contacts are sorted by (a, b)
+void detectCollisions(CollisionWorld& world, const std::vector<CollisionBody>& bodies,
+    std::vector<ContactPair>& contacts);
+
+// continuous detection: the time of impact of every sweep, with the bodies at their start
+// transforms; bodies of groups without a sweep stay in place, two moving groups are swept against
+// each other with their relative motion
+// pairs that already overlap at the start are left to detectCollisions and don't stop a sweep,
+// so overlapping objects can be pulled apart; hits[i] belongs to sweeps[i]
+void sweepCollisions(CollisionWorld& world, const std::vector<CollisionBody>& bodies,
+    const std::vector<GroupSweep>& sweeps, std::vector<SweepHit>& hits);
+
+#endif
@@ -0,0 +1,169 @@
+#include "ecs.h"
+
+#include <cstring>
+
+static const std::size_t COMPONENT_SIZES[COMPONENT_COUNT] = {
+    sizeof(Transform2D), sizeof(MeshRef), sizeof(Color), sizeof(Velocity), sizeof(Pickable),
+    sizeof(Collider), sizeof(RigidBody)
+};
+
+// chunk creation: lay the component arrays out back to back, each one 16 byte aligned
+static std::unique_ptr<Chunk> createChunk(ComponentMask mask) {
+    std::unique_ptr<Chunk> chunk(new Chunk());
+    chunk->count = 0;
+
+    std::size_t offsets[COMPONENT_COUNT];
+    std::size_t size = 0;
+    for (int type = 0; type < COMPONENT_COUNT; type++) {
+        offsets[type] = size;
+        if (mask & (1u << type))
+            size += (COMPONENT_SIZES[type] * CHUNK_CAPACITY + 15) & ~(std::size_t)15;
+    }
+
+    chunk->storage.resize(size + 16);
+    unsigned char* base = chunk->storage.data();
+    base += (16 - (uintptr_t)base % 16) % 16;
+    for (int type = 0; type < COMPONENT_COUNT; type++)
+        chunk->arrays[type] = (mask & (1u << type)) ? base + offsets[type] : NULL;
+    return chunk;
+}
+
+static int findArchetype(EcsWorld& world, ComponentMask mask) {
+    for (unsigned int i = 0; i < world.archetypes.size(); i++) {
+        if (world.archetypes[i].mask == mask)
+            return (int)i;
+    }
+
+    Archetype archetype;
+    archetype.mask = mask;
+    archetype.count = 0;
+    world.archetypes.push_back(std::move(archetype));
+    return (int)world.archetypes.size() - 1;
+}
+
+static unsigned char* slotData(Archetype& archetype, int slot, int type) {
+    Chunk& chunk = *archetype.chunks[slot / CHUNK_CAPACITY];
+    return chunk.arrays[type] + COMPONENT_SIZES[type] * (slot % CHUNK_CAPACITY);
+}
+
+// slot allocation: append to the last chunk, adding a chunk when it is full
+// the components of the new slot are zeroed
+static int allocateSlot(Archetype& archetype, Entity entity) {
+    int slot = archetype.count++;
+    if (slot / CHUNK_CAPACITY >= (int)archetype.chunks.size())
+        archetype.chunks.push_back(createChunk(archetype.mask));
+
+    Chunk& chunk = *archetype.chunks[slot / CHUNK_CAPACITY];
+    chunk.entities[slot % CHUNK_CAPACITY] = entity;
+    chunk.count++;
+    for (int type = 0; type < COMPONENT_COUNT; type++) {
+        if (archetype.mask & (1u << type))
+            std::memset(slotData(archetype, slot, type), 0, COMPONENT_SIZES[type]);
+    }
+    return slot;
+}
+
+// slot release: move the last entity of the archetype into the slot and fix its record
+static void releaseSlot(EcsWorld& world, int archetypeIndex, int slot) {
+    Archetype& archetype = world.archetypes[archetypeIndex];
+    int last = --archetype.count;
+    Chunk& lastChunk = *archetype.chunks[last / CHUNK_CAPACITY];
+    lastChunk.count--;
+    if (slot == last)
+        return;
+
+    Entity moved = lastChunk.entities[last % CHUNK_CAPACITY];
+    archetype.chunks[slot / CHUNK_CAPACITY]->entities[slot % CHUNK_CAPACITY] = moved;
+    for (int type = 0; type < COMPONENT_COUNT; type++) {
+        if (archetype.mask & (1u << type))
+            std::memcpy(slotData(archetype, slot, type), slotData(archetype, last, type), COMPONENT_SIZES[type]);
+    }
+    world.records[moved.index].slot = slot;
+}
+
+Entity createEntity(EcsWorld& world, ComponentMask mask) {
+    Entity entity;
+    if (!world.freeIndices.empty()) {
+        entity.index = world.freeIndices.back();
+        world.freeIndices.pop_back();
+    } else {
+        entity.index = (uint32_t)world.records.size();
+        world.records.push_back({-1, 0, 0});
+    }
+
+    EntityRecord& record = world.records[entity.index];
+    entity.generation = ++record.generation;
+    record.archetype = findArchetype(world, mask);
+    record.slot = allocateSlot(world.archetypes[record.archetype], entity);
+    return entity;
+}
+
+void destroyEntity(EcsWorld& world, Entity entity) {
+    if (!entityAlive(world, entity))
+        return;
+
+    EntityRecord& record = world.records[entity.index];
+    releaseSlot(world, record.archetype, record.slot);
+    record.archetype = -1;
+    world.freeIndices.push_back(entity.index);
+}
+
+bool entityAlive(const EcsWorld& world, Entity entity) {
+    return entity.generation != 0 && entity.index < world.records.size() &&
+        world.records[entity.index].generation == entity.generation &&
+        world.records[entity.index].archetype >= 0;
+}
+
+ComponentMask entityMask(const EcsWorld& world, Entity entity) {
+    if (!entityAlive(world, entity))
+        return 0;
+    return world.archetypes[world.records[entity.index].archetype].mask;
+}
+
+// archetype move: copy the components both archetypes have, the new ones start zeroed
+static void moveEntity(EcsWorld& world, Entity entity, ComponentMask mask) {
+    EntityRecord& record = world.records[entity.index];
+    int from = record.archetype;
+    int to = findArchetype(world, mask);
+    if (from == to)
+        return;
+
+    int slot = allocateSlot(world.archetypes[to], entity);
+    ComponentMask shared = world.archetypes[from].mask & mask;
+    for (int type = 0; type < COMPONENT_COUNT; type++) {
+        if (shared & (1u << type))
+            std::memcpy(slotData(world.archetypes[to], slot, type),
+                slotData(world.archetypes[from], record.slot, type), COMPONENT_SIZES[type]);
+    }
+    releaseSlot(world, from, record.slot);
+    record.archetype = to;
+    record.slot = slot;
+}
+
+void addComponents(EcsWorld& world, Entity entity, ComponentMask mask) {
+    if (entityAlive(world, entity))
+        moveEntity(world, entity, entityMask(world, entity) | mask);
+}
+
+void removeComponents(EcsWorld& world, Entity entity, ComponentMask mask) {
+    if (entityAlive(world, entity))
+        moveEntity(world, entity, entityMask(world, entity) & ~mask);
+}
+
+void* componentData(EcsWorld& world, Entity entity, ComponentType type) {
+    if (!entityAlive(world, entity))
+        return NULL;
+
+    const EntityRecord& record = world.records[entity.index];
+    Archetype& archetype = world.archetypes[record.archetype];
+    if (!(archetype.mask & (1u << type)))
+        return NULL;
+    return slotData(archetype, record.slot, type);
+}
+
+void collectChunks(EcsWorld& world, ComponentMask required, std::vector<Chunk*>& chunks) {
+    chunks.clear();
+    forEachChunk(world, required, [&](Chunk& chunk) {
+        chunks.push_back(&chunk);
+    });
+}
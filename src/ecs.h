@@ -0,0 +1,176 @@
+#ifndef ECS_H
+#define ECS_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// entity: an index into the entity records plus the generation it was created in, so a stale
+// handle to a destroyed (and reused) index is recognised; generation 0 is never valid
+struct Entity {
+    uint32_t index;
+    uint32_t generation;
+};
+
+const Entity NO_ENTITY = {0, 0};
+
+// components: plain data, copied around with memcpy when an entity changes archetype
+// position, rotation and scale of an object, node is the scene graph node it drives
+struct Transform2D {
+    glm::vec2 position;
+    float rotation;
+    float scale;
+    int node;
+};
+
+// mesh reference: index into the mesh table of the renderer, sdf draws the mesh's SDF shape instead
+struct MeshRef {
+    int mesh;
+    bool sdf;
+};
+
+// color: tint is multiplied with the vertex colors of the mesh, it is the object's own color (base,
+// set by animations) with the feedback of the systems applied, e.g. contacts
+// the vertex colors are the part's own palette slice, starting at entry palette of the palette buffer
+struct Color {
+    glm::vec3 tint;
+    glm::vec3 base;
+    int palette;
+};
+
+// velocity: object space units and radians per second
+struct Velocity {
+    glm::vec2 linear;
+    float angular;
+};
+
+// pickable: outline index for hit testing and the entity a hit selects (the owner of the part)
+struct Pickable {
+    int outline;
+    Entity owner;
+};
+
+// collider: collision shape index, parts of one object share a group and never collide
+struct Collider {
+    int shape;
+    int group;
+};
+
+// rigid body: index of the physics body, mass and moment of inertia at scale 1 and the radius of
+// the bounding circle of the whole object
+struct RigidBody {
+    int body;
+    float mass;
+    float inertia;
+    float radius;
+};
+
+enum ComponentType {
+    COMPONENT_TRANSFORM,
+    COMPONENT_MESH,
+    COMPONENT_COLOR,
+    COMPONENT_VELOCITY,
+    COMPONENT_PICKABLE,
+    COMPONENT_COLLIDER,
+    COMPONENT_RIGID_BODY,
+    COMPONENT_COUNT
+};
+
+typedef uint32_t ComponentMask;
+
+template <typename T> struct ComponentTraits;
+template <> struct ComponentTraits<Transform2D> { static const ComponentType type = COMPONENT_TRANSFORM; };
+template <> struct ComponentTraits<MeshRef> { static const ComponentType type = COMPONENT_MESH; };
+template <> struct ComponentTraits<Color> { static const ComponentType type = COMPONENT_COLOR; };
+template <> struct ComponentTraits<Velocity> { static const ComponentType type = COMPONENT_VELOCITY; };
+template <> struct ComponentTraits<Pickable> { static const ComponentType type = COMPONENT_PICKABLE; };
+template <> struct ComponentTraits<Collider> { static const ComponentType type = COMPONENT_COLLIDER; };
+template <> struct ComponentTraits<RigidBody> { static const ComponentType type = COMPONENT_RIGID_BODY; };
+
+// component bit: the mask of a single component type
+template <typename T>
+ComponentMask componentBit() {
+    return 1u << ComponentTraits<T>::type;
+}
+
+// entities per chunk
+const int CHUNK_CAPACITY = 64;
+
+// structure to store up to CHUNK_CAPACITY entities of one archetype, one contiguous array per
+// component the archetype has (NULL for the others), all in a single allocation
+struct Chunk {
+    int count;
+    Entity entities[CHUNK_CAPACITY];
+    unsigned char* arrays[COMPONENT_COUNT];
+    std::vector<unsigned char> storage;
+};
+
+// structure to store every entity with exactly one set of components
+// entities are packed: entity i of the archetype lives in chunk i / CHUNK_CAPACITY
+struct Archetype {
+    ComponentMask mask;
+    int count;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+};
+
+// structure to store where an entity lives, archetype is -1 for a free index
+struct EntityRecord {
+    int archetype;
+    int slot; // index of the entity inside its archetype
+    uint32_t generation;
+};
+
+struct EcsWorld {
+    std::vector<Archetype> archetypes;
+    std::vector<EntityRecord> records;
+    std::vector<uint32_t> freeIndices;
+};
+
+// entity creation: the components of mask are zero initialised
+Entity createEntity(EcsWorld& world, ComponentMask mask);
+
+// entity removal: the last entity of the archetype moves into the hole, arrays stay packed
+void destroyEntity(EcsWorld& world, Entity entity);
+
+bool entityAlive(const EcsWorld& world, Entity entity);
+ComponentMask entityMask(const EcsWorld& world, Entity entity);
+
+// component changes: move the entity to the archetype of its new mask, keeping shared components
+void addComponents(EcsWorld& world, Entity entity, ComponentMask mask);
+void removeComponents(EcsWorld& world, Entity entity, ComponentMask mask);
+
+// component access: NULL when the entity is dead or doesn't have the component
+// the pointer is only valid until the next creation, removal or component change
+void* componentData(EcsWorld& world, Entity entity, ComponentType type);
+
+template <typename T>
+T* getComponent(EcsWorld& world, Entity entity) {
+    return (T*)componentData(world, entity, ComponentTraits<T>::type);
+}
+
+// chunk access: the array of one component inside a chunk
+template <typename T>
+T* chunkComponents(Chunk& chunk) {
+    return (T*)chunk.arrays[ComponentTraits<T>::type];
+}
+
+// chunk collection: every non-empty chunk whose archetype has all the required components, in
+// creation order; chunks are independent, so the list can be split across threads as it is
+void collectChunks(EcsWorld& world, ComponentMask required, std::vector<Chunk*>& chunks);
+
+// chunk iteration: call fn(Chunk&) for every chunk collectChunks would return
+template <typename Fn>
+void forEachChunk(EcsWorld& world, ComponentMask required, Fn fn) {
+    for (Archetype& archetype : world.archetypes) {
+        if ((archetype.mask & required) != required)
+            continue;
+        for (const std::unique_ptr<Chunk>& chunk : archetype.chunks) {
+            if (chunk->count > 0)
+                fn(*chunk);
+        }
+    }
+}
+
+#endif
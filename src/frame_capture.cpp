@@ -0,0 +1,228 @@
+#include "frame_capture.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+// writer thread: PPM files are flipped to top row first, the ffmpeg pipe flips with -vf vflip
+static void writerLoop(FrameCapture* capture) {
+    while (true) {
+        CapturedFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(capture->mutex);
+            capture->wake.wait(lock, [capture] { return capture->stopping || !capture->queue.empty(); });
+            if (capture->queue.empty())
+                return;
+            frame = std::move(capture->queue.front());
+            capture->queue.pop_front();
+        }
+
+        bool written;
+        if (capture->pipe) {
+            written = fwrite(frame.pixels.data(), 1, frame.pixels.size(), capture->pipe) == frame.pixels.size();
+        } else {
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame_%05lu.ppm", frame.index);
+            std::ofstream file(capture->directory + name, std::ios::binary | std::ios::trunc);
+            std::size_t rowSize = (std::size_t)frame.width * 3;
+            file << "P6\n" << frame.width << " " << frame.height << "\n255\n";
+            for (int row = frame.height - 1; row >= 0; row--)
+                file.write((const char*)frame.pixels.data() + row * rowSize, rowSize);
+            written = (bool)file;
+        }
+
+        // buffer recycling: the pixel buffer goes back into the pool for the next readback
+        std::lock_guard<std::mutex> lock(capture->mutex);
+        if (written)
+            capture->framesWritten++;
+        else
+            capture->framesFailed++;
+        capture->spare.push_back(std::move(frame.pixels));
+    }
+}
+
+static void captureInit(FrameCapture& capture, int width, int height) {
+    capture.width = width;
+    capture.height = height;
+    capture.slot = 0;
+    capture.framesIssued = 0;
+    capture.pipe = NULL;
+    capture.stopping = false;
+    capture.captureTicks = 0;
+    capture.framesWritten = 0;
+    capture.framesFailed = 0;
+
+    glGenBuffers(CAPTURE_BUFFERS, capture.pbos);
+    for (int i = 0; i < CAPTURE_BUFFERS; i++) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.pbos[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)width * height * 3, NULL, GL_STREAM_READ);
+        capture.pboPending[i] = false;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    capture.writer = std::thread(writerLoop, &capture);
+}
+
+bool captureInitFiles(FrameCapture& capture, int width, int height, const std::string& directory) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cout << "ERROR: could not create capture directory " << directory << std::endl;
+        return false;
+    }
+
+    capture.directory = directory;
+    captureInit(capture, width, height);
+    return true;
+}
+
+// shell quoting: argument as one word of a popen command, shell characters in it stay literal;
+// empty when the platform shell can't quote it
+static std::string quoteShellArgument(const std::string& argument) {
+#ifdef _WIN32
+    // cmd.exe: double quotes, nothing inside them escapes a quote or stops variable expansion
+    if (argument.find_first_of("\"%!^") != std::string::npos)
+        return "";
+    return "\"" + argument + "\"";
+#else
+    // POSIX shell: nothing is special inside single quotes, an embedded quote closes the quoted
+    // part, adds an escaped quote and opens the next part
+    std::string quoted = "'";
+    for (char c : argument) {
+        if (c == '\'')
+            quoted += "'\\''";
+        else
+            quoted += c;
+    }
+    return quoted + "'";
+#endif
+}
+
+bool captureInitFfmpeg(FrameCapture& capture, int width, int height, const std::string& videoFile) {
+    std::string quotedFile = quoteShellArgument(videoFile);
+    if (quotedFile.empty()) {
+        std::cout << "ERROR: video file name " << videoFile << " can't be passed to ffmpeg" << std::endl;
+        return false;
+    }
+    std::string command = "ffmpeg -loglevel error -y -f rawvideo -pix_fmt rgb24 -s " +
+        std::to_string(width) + "x" + std::to_string(height) + " -r 60 -i - -vf vflip " + quotedFile;
+    FILE* pipe = popen(command.c_str(), "w");
+    if (!pipe) {
+        std::cout << "ERROR: could not start ffmpeg" << std::endl;
+        return false;
+    }
+
+    captureInit(capture, width, height);
+    capture.pipe = pipe;
+    return true;
+}
+
+// buffer handoff: map a finished readback, copy it out and queue it for the writer
+static void collectBuffer(FrameCapture& capture, int slot) {
+    std::size_t size = (std::size_t)capture.width * capture.height * 3;
+    CapturedFrame frame;
+    frame.index = capture.pboFrame[slot];
+    frame.width = capture.width;
+    frame.height = capture.height;
+    {
+        std::lock_guard<std::mutex> lock(capture.mutex);
+        if (!capture.spare.empty()) {
+            frame.pixels = std::move(capture.spare.back());
+            capture.spare.pop_back();
+        }
+    }
+    frame.pixels.resize(size);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.pbos[slot]);
+    void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT);
+    if (mapped) {
+        std::memcpy(frame.pixels.data(), mapped, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    capture.pboPending[slot] = false;
+
+    if (mapped) {
+        std::lock_guard<std::mutex> lock(capture.mutex);
+        capture.queue.push_back(std::move(frame));
+        capture.wake.notify_one();
+    }
+}
+
+void captureFrame(FrameCapture& capture) {
+    uint64_t start = glfwGetTimerValue();
+
+    // oldest buffer: issued CAPTURE_BUFFERS frames ago, collect it before reusing it
+    int slot = capture.slot;
+    if (capture.pboPending[slot])
+        collectBuffer(capture, slot);
+
+    // readback: into the pixel pack buffer, glReadPixels returns without waiting for the GPU
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.pbos[slot]);
+    glReadPixels(0, 0, capture.width, capture.height, GL_RGB, GL_UNSIGNED_BYTE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    capture.pboFrame[slot] = capture.framesIssued++;
+    capture.pboPending[slot] = true;
+    capture.slot = (slot + 1) % CAPTURE_BUFFERS;
+
+    capture.captureTicks += glfwGetTimerValue() - start;
+}
+
+void captureResize(FrameCapture& capture, int width, int height) {
+    if (width == capture.width && height == capture.height)
+        return;
+
+    // video: ffmpeg was started for one frame size, the readback keeps it (cropped or padded)
+    if (capture.pipe) {
+        std::cout << "INFO: window resized, the video keeps its size of " << capture.width << "x" <<
+            capture.height << std::endl;
+        return;
+    }
+
+    // pending readbacks: they have the old size, hand them over before the buffers are resized
+    for (int i = 0; i < CAPTURE_BUFFERS; i++) {
+        int slot = (capture.slot + i) % CAPTURE_BUFFERS;
+        if (capture.pboPending[slot])
+            collectBuffer(capture, slot);
+    }
+
+    capture.width = width;
+    capture.height = height;
+    for (int i = 0; i < CAPTURE_BUFFERS; i++) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, capture.pbos[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)width * height * 3, NULL, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void captureFinish(FrameCapture& capture) {
+    for (int i = 0; i < CAPTURE_BUFFERS; i++) {
+        int slot = (capture.slot + i) % CAPTURE_BUFFERS;
+        if (capture.pboPending[slot])
+            collectBuffer(capture, slot);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(capture.mutex);
+        capture.stopping = true;
+        capture.wake.notify_one();
+    }
+    capture.writer.join();
+    if (capture.pipe)
+        pclose(capture.pipe);
+    glDeleteBuffers(CAPTURE_BUFFERS, capture.pbos);
+
+    double overheadMs = capture.framesIssued ?
+        (double)capture.captureTicks * 1000.0 / glfwGetTimerFrequency() / capture.framesIssued : 0.0;
+    std::cout << "INFO: captured " << capture.framesWritten << " frames (" << capture.framesFailed <<
+        " failed), capture overhead " << overheadMs << " ms per frame" << std::endl;
+}
@@ -0,0 +1,71 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// readback depth: a frame is mapped this many frames after glReadPixels was issued,
+// by then the copy into the pixel pack buffer has finished and mapping doesn't stall
+const int CAPTURE_BUFFERS = 3;
+
+// structure to store one frame on its way to the writer thread
+struct CapturedFrame {
+    unsigned long index;
+    int width; // size at readback, the window may have been resized since
+    int height;
+    std::vector<unsigned char> pixels; // RGB, bottom row first as GL returns it
+};
+
+// structure to store the capture state
+// frames go out either as numbered PPM files in a directory or as raw RGB into an ffmpeg pipe
+struct FrameCapture {
+    int width;
+    int height;
+    unsigned int pbos[CAPTURE_BUFFERS];
+    unsigned long pboFrame[CAPTURE_BUFFERS]; // frame index held by each buffer
+    bool pboPending[CAPTURE_BUFFERS];
+    int slot;
+    unsigned long framesIssued;
+
+    std::string directory; // PPM output, empty when piping
+    FILE* pipe;            // ffmpeg stdin, NULL when writing files
+
+    // writer thread: frames to write and a pool of spare pixel buffers, both behind one mutex
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<CapturedFrame> queue;
+    std::vector<std::vector<unsigned char>> spare;
+    bool stopping;
+
+    // overhead: time spent in captureFrame on the render thread
+    uint64_t captureTicks;
+    unsigned long framesWritten;
+    unsigned long framesFailed;
+};
+
+// capture setup: write PPM files into directory, needs a current context
+bool captureInitFiles(FrameCapture& capture, int width, int height, const std::string& directory);
+
+// capture setup: pipe raw frames into a local ffmpeg that encodes them to videoFile
+// the file name is quoted for the shell, a name that can't be quoted is refused
+bool captureInitFfmpeg(FrameCapture& capture, int width, int height, const std::string& videoFile);
+
+// frame capture: queue a readback of the back buffer and hand older finished readbacks
+// to the writer thread (call after drawing, before swapping)
+void captureFrame(FrameCapture& capture);
+
+// capture resize: collect the pending readbacks and read the next frames at the new size
+// (PPM files only, a video keeps the size it was started with)
+void captureResize(FrameCapture& capture, int width, int height);
+
+// capture finish: collect outstanding readbacks, wait for the writer and report the overhead
+void captureFinish(FrameCapture& capture);
+
+#endif
@@ -0,0 +1,146 @@
+#include "frame_pacer.h"
+
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+// spin margin: the last part of the wait is spun because sleeps overshoot by up to a scheduler tick
+const double SPIN_MARGIN_SECONDS = 0.002;
+
+FramePacer pacerInit(PacingMode mode, double targetFps) {
+    FramePacer pacer = {};
+    pacerSetMode(pacer, mode, targetFps);
+    return pacer;
+}
+
+void pacerSetMode(FramePacer& pacer, PacingMode mode, double targetFps) {
+    pacer = {};
+    pacer.mode = mode;
+    pacer.targetFps = targetFps;
+    pacer.timerFrequency = glfwGetTimerFrequency();
+    pacer.minMs = 1e9;
+
+    // adaptive vsync needs the swap tear extension, fall back to plain vsync without it
+    if (mode == PACING_ADAPTIVE && !glfwExtensionSupported("WGL_EXT_swap_control_tear") &&
+            !glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+        std::cout << "WARNING: adaptive vsync unsupported, using vsync" << std::endl;
+        pacer.mode = PACING_VSYNC;
+    }
+
+    switch (pacer.mode) {
+        case PACING_VSYNC:
+            glfwSwapInterval(1);
+            break;
+        case PACING_ADAPTIVE:
+            glfwSwapInterval(-1);
+            break;
+        case PACING_NO_VSYNC:
+        case PACING_FPS_CAP:
+            glfwSwapInterval(0);
+            break;
+    }
+
+    if (pacer.mode == PACING_FPS_CAP && targetFps > 0.0)
+        pacer.frameTicks = (uint64_t)(pacer.timerFrequency / targetFps);
+}
+
+bool parsePacingMode(const char* text, PacingMode& mode, double& targetFps) {
+    std::string name = text;
+    if (name == "vsync") {
+        mode = PACING_VSYNC;
+    } else if (name == "novsync") {
+        mode = PACING_NO_VSYNC;
+    } else if (name == "adaptive") {
+        mode = PACING_ADAPTIVE;
+    } else if (name.compare(0, 4, "cap=") == 0 && std::atof(name.c_str() + 4) > 0.0) {
+        mode = PACING_FPS_CAP;
+        targetFps = std::atof(name.c_str() + 4);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string pacingModeName(PacingMode mode, double targetFps) {
+    switch (mode) {
+        case PACING_VSYNC:
+            return "vsync";
+        case PACING_NO_VSYNC:
+            return "novsync";
+        case PACING_ADAPTIVE:
+            return "adaptive";
+        case PACING_FPS_CAP:
+            break;
+    }
+    std::ostringstream name;
+    name << "cap=" << targetFps;
+    return name.str();
+}
+
+void pacerWait(FramePacer& pacer) {
+    if (pacer.mode != PACING_FPS_CAP || pacer.frameTicks == 0)
+        return;
+
+    uint64_t now = glfwGetTimerValue();
+
+    // first frame or more than a whole frame late: restart the schedule from now
+    if (pacer.deadline == 0 || now > pacer.deadline + pacer.frameTicks) {
+        pacer.deadline = now;
+        return;
+    }
+
+    // coarse wait: sleep until shortly before the deadline
+    uint64_t spinTicks = (uint64_t)(SPIN_MARGIN_SECONDS * pacer.timerFrequency);
+    if (pacer.deadline > now + spinTicks) {
+        double sleepSeconds = (double)(pacer.deadline - now - spinTicks) / pacer.timerFrequency;
+        std::this_thread::sleep_for(std::chrono::duration<double>(sleepSeconds));
+    }
+
+    // fine wait: spin on the high resolution timer for the rest
+    while (glfwGetTimerValue() < pacer.deadline)
+        std::this_thread::yield();
+}
+
+void pacerFrameDone(FramePacer& pacer) {
+    uint64_t now = glfwGetTimerValue();
+
+    if (pacer.mode == PACING_FPS_CAP && pacer.frameTicks != 0)
+        pacer.deadline += pacer.frameTicks;
+
+    if (pacer.lastSwap != 0) {
+        double intervalMs = (double)(now - pacer.lastSwap) * 1000.0 / pacer.timerFrequency;
+
+        // running statistics: Welford's update keeps the variance stable over long runs
+        pacer.frames++;
+        double delta = intervalMs - pacer.meanMs;
+        pacer.meanMs += delta / pacer.frames;
+        pacer.m2 += delta * (intervalMs - pacer.meanMs);
+
+        if (intervalMs < pacer.minMs) pacer.minMs = intervalMs;
+        if (intervalMs > pacer.maxMs) pacer.maxMs = intervalMs;
+    }
+    pacer.lastSwap = now;
+}
+
+void pacerIdle(FramePacer& pacer) {
+    pacer.lastSwap = 0;
+    pacer.deadline = 0;
+}
+
+void pacerReport(const FramePacer& pacer) {
+    std::string mode = pacingModeName(pacer.mode, pacer.targetFps);
+    if (pacer.frames == 0) {
+        std::cout << "INFO: frame pacing (" << mode << "): no consecutive frames measured" << std::endl;
+        return;
+    }
+
+    double jitterMs = pacer.frames > 1 ? std::sqrt(pacer.m2 / (pacer.frames - 1)) : 0.0;
+    std::cout << "INFO: frame pacing (" << mode << "): " << pacer.frames << " intervals, mean " <<
+        pacer.meanMs << " ms, jitter " << jitterMs << " ms, min " << pacer.minMs <<
+        " ms, max " << pacer.maxMs << " ms" << std::endl;
+}
@@ -0,0 +1,56 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <cstdint>
+#include <string>
+
+// pacing modes: how the end of a frame is synchronised with the display
+enum PacingMode {
+    PACING_VSYNC,     // swap interval 1: wait for every vertical blank
+    PACING_NO_VSYNC,  // swap interval 0: present as fast as possible
+    PACING_ADAPTIVE,  // swap interval -1: vsync, but tear instead of stalling on a late frame
+    PACING_FPS_CAP    // swap interval 0, the pacer sleeps and spins up to a target frame rate
+};
+
+// structure to store the pacing state and the frame interval statistics
+struct FramePacer {
+    PacingMode mode;
+    double targetFps;
+
+    uint64_t timerFrequency; // glfwGetTimerValue ticks per second
+    uint64_t frameTicks;     // target frame length in ticks (fps cap only)
+    uint64_t deadline;       // when the next frame may be presented (fps cap only)
+    uint64_t lastSwap;       // 0: no previous frame to measure against
+
+    // frame interval statistics in milliseconds (running mean/variance)
+    unsigned long frames;
+    double meanMs;
+    double m2;
+    double minMs;
+    double maxMs;
+};
+
+// pacer setup: apply the swap interval for the mode, needs a current context
+FramePacer pacerInit(PacingMode mode, double targetFps);
+
+// mode switch: apply another mode at runtime, the statistics start over
+void pacerSetMode(FramePacer& pacer, PacingMode mode, double targetFps);
+
+// mode names: "vsync", "novsync", "adaptive" or "cap=<fps>", as given to --pacing
+// parsing returns false for an unknown name and leaves mode and targetFps unchanged
+bool parsePacingMode(const char* text, PacingMode& mode, double& targetFps);
+std::string pacingModeName(PacingMode mode, double targetFps);
+
+// frame cap: sleep, then spin for the last stretch, until the next deadline (call before swapping)
+void pacerWait(FramePacer& pacer);
+
+// frame end: record the interval since the previous swap (call right after swapping)
+void pacerFrameDone(FramePacer& pacer);
+
+// idle gap: the loop stopped rendering, don't count the pause as a frame interval
+void pacerIdle(FramePacer& pacer);
+
+// pacing report: print the mode, mean interval and jitter
+void pacerReport(const FramePacer& pacer);
+
+#endif
@@ -1838,3 +1838,155 @@ int gladLoadGLLoader(GLADloadproc load) {
 	return GLVersion.major != 0 || GLVersion.minor != 0;
 }
 
+
+/* Minimal loader: instead of resolving every 1.0 - 3.3 entry point, resolve only the
+ * functions the application actually calls. Keep this manifest in sync with the code,
+ * anything missing here stays NULL when the program is built with GLAD_MINIMAL_LOADER.
+ */
+struct gladManifestEntry {
+    const char *name;
+    void **proc;
+};
+
+#define GLAD_MANIFEST_ENTRY(name) { #name, (void**)&glad_##name }
+
+static const struct gladManifestEntry glad_manifest[] = {
+    GLAD_MANIFEST_ENTRY(glActiveTexture),
+    GLAD_MANIFEST_ENTRY(glAttachShader),
+    GLAD_MANIFEST_ENTRY(glBindBuffer),
+    GLAD_MANIFEST_ENTRY(glBindTexture),
+    GLAD_MANIFEST_ENTRY(glBindVertexArray),
+    GLAD_MANIFEST_ENTRY(glBlendFunc),
+    GLAD_MANIFEST_ENTRY(glBufferData),
+    GLAD_MANIFEST_ENTRY(glBufferSubData),
+    GLAD_MANIFEST_ENTRY(glClear),
+    GLAD_MANIFEST_ENTRY(glClearColor),
+    GLAD_MANIFEST_ENTRY(glCompileShader),
+    GLAD_MANIFEST_ENTRY(glCreateProgram),
+    GLAD_MANIFEST_ENTRY(glCreateShader),
+    GLAD_MANIFEST_ENTRY(glDeleteBuffers),
+    GLAD_MANIFEST_ENTRY(glDeleteProgram),
+    GLAD_MANIFEST_ENTRY(glDeleteQueries),
+    GLAD_MANIFEST_ENTRY(glDeleteShader),
+    GLAD_MANIFEST_ENTRY(glDeleteTextures),
+    GLAD_MANIFEST_ENTRY(glDeleteVertexArrays),
+    GLAD_MANIFEST_ENTRY(glDetachShader),
+    GLAD_MANIFEST_ENTRY(glDrawArraysInstanced),
+    GLAD_MANIFEST_ENTRY(glDrawElements),
+    GLAD_MANIFEST_ENTRY(glEnable),
+    GLAD_MANIFEST_ENTRY(glEnableVertexAttribArray),
+    GLAD_MANIFEST_ENTRY(glGenBuffers),
+    GLAD_MANIFEST_ENTRY(glGenQueries),
+    GLAD_MANIFEST_ENTRY(glGenTextures),
+    GLAD_MANIFEST_ENTRY(glGenVertexArrays),
+    GLAD_MANIFEST_ENTRY(glGetIntegerv),
+    GLAD_MANIFEST_ENTRY(glGetProgramInfoLog),
+    GLAD_MANIFEST_ENTRY(glGetProgramiv),
+    GLAD_MANIFEST_ENTRY(glGetQueryObjectiv),
+    GLAD_MANIFEST_ENTRY(glGetQueryObjectui64v),
+    GLAD_MANIFEST_ENTRY(glGetShaderInfoLog),
+    GLAD_MANIFEST_ENTRY(glGetShaderiv),
+    GLAD_MANIFEST_ENTRY(glGetStringi),
+    GLAD_MANIFEST_ENTRY(glGetUniformLocation),
+    GLAD_MANIFEST_ENTRY(glLinkProgram),
+    GLAD_MANIFEST_ENTRY(glMapBufferRange),
+    GLAD_MANIFEST_ENTRY(glPixelStorei),
+    GLAD_MANIFEST_ENTRY(glQueryCounter),
+    GLAD_MANIFEST_ENTRY(glReadPixels),
+    GLAD_MANIFEST_ENTRY(glShaderSource),
+    GLAD_MANIFEST_ENTRY(glTexBuffer),
+    GLAD_MANIFEST_ENTRY(glUnmapBuffer),
+    GLAD_MANIFEST_ENTRY(glUniform1i),
+    GLAD_MANIFEST_ENTRY(glUniform3fv),
+    GLAD_MANIFEST_ENTRY(glUniformMatrix4fv),
+    GLAD_MANIFEST_ENTRY(glUseProgram),
+    GLAD_MANIFEST_ENTRY(glVertexAttrib3f),
+    GLAD_MANIFEST_ENTRY(glVertexAttribDivisor),
+    GLAD_MANIFEST_ENTRY(glVertexAttribPointer),
+    GLAD_MANIFEST_ENTRY(glViewport)
+};
+
+int gladManifestSize(void) {
+    return (int)(sizeof(glad_manifest) / sizeof(glad_manifest[0]));
+}
+
+int gladLoadGLLoaderMinimal(GLADloadproc load) {
+    int index;
+
+    GLVersion.major = 0; GLVersion.minor = 0;
+    glGetString = (PFNGLGETSTRINGPROC)load("glGetString");
+    if(glGetString == NULL) return 0;
+    if(glGetString(GL_VERSION) == NULL) return 0;
+    find_coreGL();
+    if(!GLAD_GL_VERSION_3_3) return 0;
+
+    /* no extension scan: nothing in the manifest depends on one, see gladHasExtension */
+    for(index = 0; index < gladManifestSize(); index++) {
+        *glad_manifest[index].proc = load(glad_manifest[index].name);
+        if(*glad_manifest[index].proc == NULL) return 0;
+    }
+    return 1;
+}
+
+/* Hashed extension lookup: an open addressing table of FNV-1a hashes and extension
+ * indices, so a query costs one hash and usually one strcmp instead of a list scan.
+ */
+static unsigned int *ext_hashes = NULL;
+static int *ext_indices = NULL;
+static unsigned int ext_table_mask = 0;
+
+static unsigned int hash_ext(const char *ext) {
+    unsigned int hash = 2166136261u;
+    for(; *ext; ext++) {
+        hash ^= (unsigned char)*ext;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int build_ext_table(void) {
+    int count = 0, index;
+    unsigned int size = 16, slot;
+
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    while(size < (unsigned int)count * 2) size <<= 1;
+
+    ext_hashes = (unsigned int*)calloc(size, sizeof *ext_hashes);
+    ext_indices = (int*)malloc(size * sizeof *ext_indices);
+    if(ext_hashes == NULL || ext_indices == NULL) {
+        free(ext_hashes); free(ext_indices);
+        ext_hashes = NULL; ext_indices = NULL;
+        return 0;
+    }
+    ext_table_mask = size - 1;
+
+    for(index = 0; index < count; index++) {
+        const char *name = (const char*)glGetStringi(GL_EXTENSIONS, index);
+        unsigned int hash;
+        if(name == NULL) continue;
+
+        /* hash 0 marks an empty slot */
+        hash = hash_ext(name) | 1u;
+        slot = hash & ext_table_mask;
+        while(ext_hashes[slot] != 0) slot = (slot + 1) & ext_table_mask;
+        ext_hashes[slot] = hash;
+        ext_indices[slot] = index;
+    }
+    return 1;
+}
+
+int gladHasExtension(const char *ext) {
+    unsigned int hash, slot;
+
+    if(ext == NULL) return 0;
+    if(ext_hashes == NULL && !build_ext_table()) return 0;
+
+    hash = hash_ext(ext) | 1u;
+    for(slot = hash & ext_table_mask; ext_hashes[slot] != 0; slot = (slot + 1) & ext_table_mask) {
+        if(ext_hashes[slot] == hash &&
+            strcmp((const char*)glGetStringi(GL_EXTENSIONS, ext_indices[slot]), ext) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "gpu_timer.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+
+const char* const PASS_NAMES[PASS_COUNT] = {"clear", "objects"};
+
+// result collection: read one slot back if the GPU is done with it, otherwise drop it
+static void collectSlot(GpuTimer& timer, int slot) {
+    for (int pass = 0; pass < PASS_COUNT; pass++) {
+        if (!timer.issued[slot][pass])
+            continue;
+        timer.issued[slot][pass] = false;
+
+        int available = 0;
+        glGetQueryObjectiv(timer.queries[slot][pass][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            timer.passes[pass].gpuDropped++;
+            continue;
+        }
+
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(timer.queries[slot][pass][0], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(timer.queries[slot][pass][1], GL_QUERY_RESULT, &end);
+        timer.passes[pass].gpuMs += (double)(end - begin) / 1.0e6;
+        timer.passes[pass].gpuSamples++;
+    }
+}
+
+void gpuTimerInit(GpuTimer& timer) {
+    timer = {};
+    timer.timerFrequency = glfwGetTimerFrequency();
+    glGenQueries(GPU_TIMER_LATENCY * PASS_COUNT * 2, &timer.queries[0][0][0]);
+}
+
+void beginPass(GpuTimer& timer, RenderPass pass) {
+    timer.cpuBegin[pass] = glfwGetTimerValue();
+    glQueryCounter(timer.queries[timer.slot][pass][0], GL_TIMESTAMP);
+}
+
+void endPass(GpuTimer& timer, RenderPass pass) {
+    glQueryCounter(timer.queries[timer.slot][pass][1], GL_TIMESTAMP);
+    timer.issued[timer.slot][pass] = true;
+
+    uint64_t cpuTicks = glfwGetTimerValue() - timer.cpuBegin[pass];
+    timer.passes[pass].cpuMs += (double)cpuTicks * 1000.0 / timer.timerFrequency;
+    timer.passes[pass].cpuSamples++;
+}
+
+void gpuTimerFrameEnd(GpuTimer& timer) {
+    // the next slot was written GPU_TIMER_LATENCY - 1 frames ago, read it before reusing it
+    timer.slot = (timer.slot + 1) % GPU_TIMER_LATENCY;
+    collectSlot(timer, timer.slot);
+}
+
+void gpuTimerReport(const GpuTimer& timer) {
+    for (int pass = 0; pass < PASS_COUNT; pass++) {
+        const PassTiming& timing = timer.passes[pass];
+        double cpuMs = timing.cpuSamples ? timing.cpuMs / timing.cpuSamples : 0.0;
+        double gpuMs = timing.gpuSamples ? timing.gpuMs / timing.gpuSamples : 0.0;
+        std::cout << "INFO: pass " << PASS_NAMES[pass] << ": cpu " << cpuMs << " ms, gpu " <<
+            gpuMs << " ms (" << timing.gpuSamples << " samples, " << timing.gpuDropped <<
+            " not ready)" << std::endl;
+    }
+}
+
+void gpuTimerDelete(GpuTimer& timer) {
+    glDeleteQueries(GPU_TIMER_LATENCY * PASS_COUNT * 2, &timer.queries[0][0][0]);
+}
@@ -0,0 +1,53 @@
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include <cstdint>
+
+// render passes: every pass gets its own CPU and GPU timing
+enum RenderPass {
+    PASS_CLEAR,
+    PASS_OBJECTS,
+    PASS_COUNT
+};
+
+// readback latency: results are read this many frames after they were issued, by then the
+// GPU has long finished them and reading never stalls the pipeline
+const int GPU_TIMER_LATENCY = 4;
+
+// structure to store the accumulated timings of one pass
+struct PassTiming {
+    double cpuMs;
+    double gpuMs;
+    unsigned long cpuSamples;
+    unsigned long gpuSamples;
+    unsigned long gpuDropped; // results that weren't ready in time and were skipped
+};
+
+// structure to store the ring of timestamp queries (one begin/end pair per pass and frame)
+struct GpuTimer {
+    unsigned int queries[GPU_TIMER_LATENCY][PASS_COUNT][2];
+    bool issued[GPU_TIMER_LATENCY][PASS_COUNT];
+    uint64_t cpuBegin[PASS_COUNT];
+    uint64_t timerFrequency;
+    int slot; // ring slot the current frame writes to
+
+    PassTiming passes[PASS_COUNT];
+};
+
+// timer setup: create the query objects, needs a current context
+void gpuTimerInit(GpuTimer& timer);
+
+// pass markers: put around the GL calls of one pass
+void beginPass(GpuTimer& timer, RenderPass pass);
+void endPass(GpuTimer& timer, RenderPass pass);
+
+// frame end: move to the next ring slot and collect the results it still holds
+void gpuTimerFrameEnd(GpuTimer& timer);
+
+// timing report: average CPU and GPU time per pass
+void gpuTimerReport(const GpuTimer& timer);
+
+// timer cleanse: delete the query objects
+void gpuTimerDelete(GpuTimer& timer);
+
+#endif
@@ -0,0 +1,128 @@
+#include "image_compare.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+bool loadPpm(const std::string& path, Image& image) {
+    std::ifstream file(path, std::ios::binary);
+    std::string magic;
+    int maxValue = 0;
+    if (!(file >> magic >> image.width >> image.height >> maxValue) || magic != "P6" || maxValue != 255)
+        return false;
+    file.get(); // single whitespace after the header
+
+    image.pixels.resize((std::size_t)image.width * image.height * 3);
+    return (bool)file.read((char*)image.pixels.data(), image.pixels.size());
+}
+
+bool savePpm(const std::string& path, const Image& image) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "P6\n" << image.width << " " << image.height << "\n255\n";
+    file.write((const char*)image.pixels.data(), image.pixels.size());
+    return (bool)file;
+}
+
+ImageDiff compareImages(const Image& result, const Image& golden, double tolerance,
+        double maxBadFraction, Image* diff) {
+    ImageDiff outcome = {false, 255.0, 255.0, 0};
+    if (result.width != golden.width || result.height != golden.height)
+        return outcome;
+
+    std::size_t pixelCount = (std::size_t)result.width * result.height;
+    if (diff) {
+        diff->width = result.width;
+        diff->height = result.height;
+        diff->pixels.assign(pixelCount * 3, 0);
+    }
+
+    double total = 0.0;
+    outcome.maxDelta = 0.0;
+    for (std::size_t i = 0; i < pixelCount; i++) {
+        const unsigned char* a = &result.pixels[i * 3];
+        const unsigned char* b = &golden.pixels[i * 3];
+        double delta = 0.299 * std::abs(a[0] - b[0]) + 0.587 * std::abs(a[1] - b[1]) +
+            0.114 * std::abs(a[2] - b[2]);
+
+        total += delta;
+        outcome.maxDelta = std::max(outcome.maxDelta, delta);
+        if (delta > tolerance) {
+            outcome.badPixels++;
+            // diff image: failing pixels in red, scaled by how far off they are
+            if (diff)
+                diff->pixels[i * 3] = (unsigned char)std::min(255.0, 64.0 + delta * 4.0);
+        } else if (diff) {
+            // matching pixels: dimmed golden luminance for orientation
+            diff->pixels[i * 3 + 1] = diff->pixels[i * 3 + 2] =
+                (unsigned char)((0.299 * b[0] + 0.587 * b[1] + 0.114 * b[2]) / 4.0);
+        }
+    }
+
+    outcome.meanDelta = pixelCount ? total / pixelCount : 0.0;
+    outcome.match = outcome.badPixels <= maxBadFraction * pixelCount;
+    return outcome;
+}
+
+int compareWithGolden(const std::string& resultDirectory, const std::string& goldenDirectory,
+        double tolerance, double maxBadFraction) {
+    std::vector<std::string> names;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(goldenDirectory, error)) {
+        if (entry.path().extension() == ".ppm")
+            names.push_back(entry.path().filename().string());
+    }
+    if (error || names.empty()) {
+        std::cout << "ERROR: no golden images in " << goldenDirectory << std::endl;
+        return 1;
+    }
+    std::sort(names.begin(), names.end());
+
+    // work distribution: every worker takes the next unclaimed image until none are left
+    std::atomic<std::size_t> next(0);
+    std::atomic<int> failures(0);
+    std::mutex outputMutex;
+    auto worker = [&]() {
+        Image result, golden, diff;
+        for (std::size_t i = next++; i < names.size(); i = next++) {
+            std::string resultPath = resultDirectory + "/" + names[i];
+            bool loaded = loadPpm(resultPath, result) && loadPpm(goldenDirectory + "/" + names[i], golden);
+            bool sameSize = loaded && result.width == golden.width && result.height == golden.height;
+            ImageDiff outcome = {false, 255.0, 255.0, 0};
+            diff.width = diff.height = 0; // the worker's previous image must not leak into this one
+            if (sameSize)
+                outcome = compareImages(result, golden, tolerance, maxBadFraction, &diff);
+            if (outcome.match)
+                continue;
+
+            failures++;
+            if (diff.width > 0)
+                savePpm(resultDirectory + "/diff_" + names[i], diff);
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            if (!loaded)
+                std::cout << "ERROR: " << names[i] << ": missing or unreadable image" << std::endl;
+            else if (!sameSize)
+                std::cout << "ERROR: " << names[i] << ": size " << result.width << "x" << result.height <<
+                    ", expected " << golden.width << "x" << golden.height << std::endl;
+            else
+                std::cout << "ERROR: " << names[i] << ": " << outcome.badPixels << " pixels off, max " <<
+                    outcome.maxDelta << ", mean " << outcome.meanDelta << std::endl;
+        }
+    };
+
+    unsigned int threadCount = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned int)names.size()));
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; t++)
+        threads.emplace_back(worker);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::cout << "INFO: golden comparison: " << names.size() - failures << " of " << names.size() <<
+        " images match" << std::endl;
+    return failures;
+}
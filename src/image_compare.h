@@ -0,0 +1,38 @@
+#ifndef IMAGE_COMPARE_H
+#define IMAGE_COMPARE_H
+
+#include <string>
+#include <vector>
+
+// structure to store an RGB image, top row first
+struct Image {
+    int width;
+    int height;
+    std::vector<unsigned char> pixels;
+};
+
+// structure to store the outcome of one image comparison
+struct ImageDiff {
+    bool match;
+    double maxDelta;     // largest weighted per pixel difference, 0 - 255
+    double meanDelta;
+    unsigned long badPixels; // pixels whose difference exceeds the tolerance
+};
+
+// PPM files: binary P6 with 8 bits per channel, as written by the frame capture
+bool loadPpm(const std::string& path, Image& image);
+bool savePpm(const std::string& path, const Image& image);
+
+// image comparison: per pixel difference weighted by luminance sensitivity
+// (0.299 R, 0.587 G, 0.114 B), so a shift the eye barely sees counts less than one it sees;
+// the images match when at most maxBadFraction of the pixels differ by more than tolerance
+ImageDiff compareImages(const Image& result, const Image& golden, double tolerance,
+    double maxBadFraction, Image* diff);
+
+// golden comparison: compare every PPM in goldenDirectory against the file of the same name
+// in resultDirectory on all cores, a diff_<name> image is written next to each failing result
+// returns the number of failing images
+int compareWithGolden(const std::string& resultDirectory, const std::string& goldenDirectory,
+    double tolerance, double maxBadFraction);
+
+#endif
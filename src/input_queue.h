@@ -0,0 +1,85 @@
+#ifndef INPUT_QUEUE_H
+#define INPUT_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// input event types: everything the GLFW callbacks can report
+enum InputEventType {
+    INPUT_MOUSE_PRESS,
+    INPUT_MOUSE_RELEASE,
+    INPUT_CURSOR_MOVE,
+    INPUT_SCROLL,
+    INPUT_KEY
+};
+
+// structure to store one timestamped input event
+// x/y hold the cursor position for mouse events, the offsets for scroll events
+// and the key and action for key events
+struct InputEvent {
+    InputEventType type;
+    double time;
+    double x;
+    double y;
+};
+
+// single-producer/single-consumer ring: the GLFW callbacks push, the simulation pops
+// capacity must be a power of two, one slot is kept free to tell full from empty
+// frequent events (cursor moves) are pushed with a reserve, so a burst of them leaves room for
+// the events that must not get lost (mouse buttons, keys); dropped events are counted
+template <std::size_t Capacity>
+class InputQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // producer side: returns false (event dropped) when the ring is full, or when pushing would
+    // leave fewer than reserve slots free
+    bool push(const InputEvent& event, std::size_t reserve = 0) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t next = (head + 1) & (Capacity - 1);
+        std::size_t used = (head - tail_.load(std::memory_order_acquire)) & (Capacity - 1);
+        if (used + 1 + reserve > Capacity - 1) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        events_[head] = event;
+        head_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side: returns false when there is nothing left to read
+    bool pop(InputEvent& event) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire))
+            return false;
+
+        event = events_[tail];
+        tail_.store((tail + 1) & (Capacity - 1), std::memory_order_release);
+        return true;
+    }
+
+    // consumer side: look at the next event without removing it
+    bool peek(InputEvent& event) const {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire))
+            return false;
+
+        event = events_[tail];
+        return true;
+    }
+
+    // events dropped since the start, readable from either side
+    unsigned long dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // head and tail live on separate cache lines so producer and consumer don't false-share
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::atomic<unsigned long> dropped_{0};
+    InputEvent events_[Capacity];
+};
+
+#endif
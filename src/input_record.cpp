@@ -0,0 +1,126 @@
+#include "input_record.h"
+
+#include <iostream>
+
+// file layout: magic, version, then per record: tick, time, keys, event count, events
+// every event is stored as type (1 byte) and x/y (8 bytes each)
+// a record without keys and events is the end marker, its tick the number of simulated ticks
+// version 2: ticks count simulated frames (version 1 counted loop iterations and had no end marker)
+const uint32_t INPUT_LOG_MAGIC = 0x43455249; // "IREC"
+const uint32_t INPUT_LOG_VERSION = 2;
+
+template <typename T>
+static void writeValue(std::fstream& file, T value) {
+    file.write((const char*)&value, sizeof(value));
+}
+
+template <typename T>
+static bool readValue(std::fstream& file, T& value) {
+    return (bool)file.read((char*)&value, sizeof(value));
+}
+
+bool openInputRecording(InputLog& log, const char* path) {
+    log.file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    log.writing = true;
+    log.frames = 0;
+    log.ended = false;
+    log.hasNext = false;
+    if (!log.file) {
+        std::cout << "ERROR: could not create input recording " << path << std::endl;
+        return false;
+    }
+
+    writeValue(log.file, INPUT_LOG_MAGIC);
+    writeValue(log.file, INPUT_LOG_VERSION);
+    return true;
+}
+
+bool openInputReplay(InputLog& log, const char* path) {
+    log.file.open(path, std::ios::in | std::ios::binary);
+    log.writing = false;
+    log.frames = 0;
+    log.ended = false;
+    log.hasNext = false;
+
+    uint32_t magic = 0, version = 0;
+    if (!log.file || !readValue(log.file, magic) || !readValue(log.file, version) ||
+            magic != INPUT_LOG_MAGIC || version != INPUT_LOG_VERSION) {
+        std::cout << "ERROR: " << path << " is not an input recording" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static void writeRecord(InputLog& log, const InputFrame& frame) {
+    writeValue(log.file, frame.tick);
+    writeValue(log.file, frame.time);
+    writeValue(log.file, frame.keys);
+    writeValue(log.file, (uint16_t)frame.events.size());
+    for (const InputEvent& event : frame.events) {
+        writeValue(log.file, (uint8_t)event.type);
+        writeValue(log.file, event.x);
+        writeValue(log.file, event.y);
+    }
+}
+
+void writeInputFrame(InputLog& log, const InputFrame& frame) {
+    if (frame.keys == 0 && frame.events.empty())
+        return;
+
+    writeRecord(log, frame);
+    log.frames++;
+}
+
+void endInputRecording(InputLog& log, uint32_t ticks) {
+    InputFrame marker = {ticks, 0.0f, 0, {}};
+    writeRecord(log, marker);
+}
+
+static bool readRecord(InputLog& log, InputFrame& frame) {
+    uint16_t count = 0;
+    if (!readValue(log.file, frame.tick) || !readValue(log.file, frame.time) ||
+            !readValue(log.file, frame.keys) || !readValue(log.file, count))
+        return false;
+
+    frame.events.resize(count);
+    for (InputEvent& event : frame.events) {
+        uint8_t type = 0;
+        if (!readValue(log.file, type) || !readValue(log.file, event.x) || !readValue(log.file, event.y))
+            return false;
+        event.type = (InputEventType)type;
+        event.time = frame.time;
+    }
+    return true;
+}
+
+void readInputTick(InputLog& log, uint32_t tick, InputFrame& frame) {
+    frame.tick = tick;
+    frame.keys = 0;
+    frame.events.clear();
+
+    while (!log.ended) {
+        // look ahead: a record of a later tick stays for that tick, a truncated file ends the replay
+        if (!log.hasNext) {
+            log.hasNext = readRecord(log, log.next);
+            log.ended = !log.hasNext;
+            continue;
+        }
+        if (log.next.tick > tick)
+            break;
+
+        log.hasNext = false;
+        if (log.next.keys == 0 && log.next.events.empty()) {
+            log.ended = true;
+            break;
+        }
+        frame.time = log.next.time;
+        frame.keys = log.next.keys;
+        frame.events.insert(frame.events.end(), log.next.events.begin(), log.next.events.end());
+        log.frames++;
+    }
+}
+
+void closeInputLog(InputLog& log) {
+    if (log.file.is_open())
+        log.file.close();
+}
@@ -0,0 +1,54 @@
+#ifndef INPUT_RECORD_H
+#define INPUT_RECORD_H
+
+#include "input_queue.h"
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+// structure to store the input of one simulation tick
+// tick is the number of ticks simulated before the input was applied, so input that arrives while
+// the loop idles shares the tick of the next simulated frame
+// keys is a bit mask over the held transform keys, events are already coalesced
+struct InputFrame {
+    uint32_t tick;
+    float time; // seconds since the recording started, informational only
+    uint32_t keys;
+    std::vector<InputEvent> events;
+};
+
+// structure to store an open recording or replay log
+// a recording ends with an end marker holding the number of simulated ticks, so a replay also
+// simulates the ticks without input (motion, animations) up to where the recording stopped
+// replays read one record ahead (next) to merge the records of a tick
+struct InputLog {
+    std::fstream file;
+    bool writing;
+    uint32_t frames; // records written or read
+    bool ended;      // replay: the end of the recording was reached
+    bool hasNext;
+    InputFrame next;
+};
+
+// log creation: start recording to path, false when the file can't be written
+bool openInputRecording(InputLog& log, const char* path);
+
+// log replay: open a recording for playback, false when the file is missing or not a recording
+bool openInputReplay(InputLog& log, const char* path);
+
+// tick record: append the input of one loop iteration, iterations without keys or events are skipped
+void writeInputFrame(InputLog& log, const InputFrame& frame);
+
+// recording end: write the end marker, ticks is the number of ticks simulated in total
+void endInputRecording(InputLog& log, uint32_t ticks);
+
+// tick replay: the input of simulation tick tick, every record of that tick merged (events in
+// order, the keys of the last record); a tick without records has no input
+// sets log.ended once the recording is over: the input of this tick is still to be applied,
+// but the tick itself is not simulated any more
+void readInputTick(InputLog& log, uint32_t tick, InputFrame& frame);
+
+void closeInputLog(InputLog& log);
+
+#endif
@@ -4,56 +4,232 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "collision.h"
+#include "ecs.h"
+#include "animation.h"
+#include "frame_capture.h"
+#include "frame_pacer.h"
+#include "gpu_timer.h"
+#include "image_compare.h"
+#include "input_queue.h"
+#include "input_record.h"
+#include "palette.h"
+#include "physics.h"
+#include "redraw.h"
+#include "picking.h"
+#include "scene_graph.h"
+#include "sdf_renderer.h"
+#include "shader_manager.h"
+#include "shader_watcher.h"
+#include "trace.h"
+#include "viewport.h"
+
 const unsigned int SCR_WIDTH = 640;
 const unsigned int SCR_HEIGHT = 480;
 
-glm::vec3 translation(0.0f, 0.0f, 0.0f); // movement speed object one
-glm::vec3 translation2(0.0f, 0.0f, 0.0f); // movement speed object two
+// window size: the viewport, projection and cursor mapping of the current size
+// the size callbacks only flag a change, the loop rebuilds the size dependent state once
+Viewport viewport = viewportInit();
+bool viewportChanged = false;
 
-float rotationSpeed = 0.0f; // rotation speed object one
-float rotationSpeed2 = 0.0f; // rotation speed object two
+// entities: every drawn part is an entity, its state lives in components (see ecs.h)
+// the keyboard controls object one (decagon) and object two (house)
+EcsWorld world;
+Entity controlledEntities[2] = {NO_ENTITY, NO_ENTITY};
 
-float scaleSpeed = 0.0f; // scale speed (factor) object one
-float scaleSpeed2 = 0.0f; // scale speed (factor) object two
+// scene graph: world transforms of every part, driven by the Transform2D components
+SceneGraph scene = sceneGraphInit();
 
 bool isDragging = false; // Is the mouse currently dragging?
-int draggedObject = -1; // -1: none, 0: object one, 1: object two
+Entity draggedEntity = NO_ENTITY; // the object being dragged
 double lastX, lastY;
 
+// on-demand redraw: wait for events while idle and render only when the scene changed
+// redraw.dirty: does the next frame differ from the one on screen?
+RedrawState redraw = redrawInit(true);
+
+// frame pacing: swap interval mode and the frame rate used by PACING_FPS_CAP
+// "--pacing vsync|novsync|adaptive|cap=<fps>" selects the mode, "F4" cycles through them
+PacingMode pacingMode = PACING_VSYNC;
+double targetFps = 60.0;
+bool cyclePacing = false; // switch to the next mode before the next frame
+
+// shader files: loaded from disk and recompiled when they change on disk
+// the directory is "--shaders <directory>", or looked up relative to the executable (see
+// findShaderDirectory); the built-in sources below are used for any file that can't be read
+std::string shaderDirectory;
+bool shaderHotReload = true;
+
+// structure to store which files a shader program is built from
+struct ShaderFiles {
+    int handle;
+    std::string vertexFile;
+    std::string fragmentFile;
+};
+
+// frame tracing: "--trace <file>" records a timeline of every frame, written on "F12" and on exit
+bool traceFrames = false;
+const char* traceFile = "trace.json";
+
+// input source: live input, live input written to a recording, or a recording played back
+// a replay feeds one recorded tick per frame, so the final state is identical on every run
+enum InputSource {
+    INPUT_SOURCE_LIVE,
+    INPUT_SOURCE_RECORD,
+    INPUT_SOURCE_REPLAY
+};
+InputSource inputSource = INPUT_SOURCE_LIVE;
+const char* inputLogFile = NULL;
+
+// anti-aliasing: analytic edge smoothing in the fragment shader, optionally MSAA for comparison
+bool edgeSmoothing = true;
+int msaaSamples = 0;
+
+// SDF rendering: only meshes with a shape description can use it, "F2" toggles the decagon
+bool decagonAsSdf = false;
+
+// frame capture: dump every rendered frame as PPM files or into an ffmpeg encoded video
+const char* captureDirectory = NULL;
+const char* captureVideo = NULL;
+
+// golden images: compare the captured frames against these and fail on a mismatch
+// tolerance is the weighted per pixel difference (0 - 255), a few pixels may exceed it
+const char* goldenDirectory = NULL;
+double goldenTolerance = 8.0;
+double goldenMaxBadFraction = 0.001;
+
+// input events: filled by the GLFW callbacks, drained once per frame by drainInput()
+// cursor moves and scrolls leave the last INPUT_RESERVE slots to button and key events
+const std::size_t INPUT_RESERVE = 32;
+InputQueue<256> inputQueue;
+unsigned long inputDropped = 0; // drops already reported
+
 // structure to store and output figure vectors
+// outline lists the border vertices in order, it is used for picking and edge smoothing
+// vertexSize is the number of floats per vertex: position and palette index (4), plus edge distances (7)
+// palette holds the default colors, every object drawing the figure gets its own copy
 struct Figure {
     std::vector<float> vertices;
     std::vector<unsigned int> indices;
+    std::vector<unsigned int> outline;
+    std::vector<glm::vec3> palette;
+    unsigned int vertexSize = 4;
 };
 
+// object origins: where the objects sit before any user translation
+const glm::vec2 decagonOrigin(-0.5f, 0.0f);
+const glm::vec2 houseOrigin(0.5f, 0.0f);
+
+// picking outlines: referenced by the Pickable components
+std::vector<std::vector<glm::vec2>> pickOutlines;
+
+// collision: shapes referenced by the Collider components (one per picking outline, same index)
+// and the contacts of the last frame; objects in contact are drawn with contactTint
+CollisionWorld collisionWorld;
+std::vector<CollisionBody> collisionBodies;
+std::vector<Entity> collisionEntities; // entity of every body, same index
+std::vector<ContactPair> contacts;
+unsigned long contactFrames = 0;
+const glm::vec3 contactTint(1.0f, 0.55f, 0.55f);
+
+// drags: the cursor motion of every dragged object is collected during input and applied by
+// dragSystem as one batch of sweeps, so a fast drag stops at the first object in its way instead
+// of jumping through it; the sweep group of an object is its entity index (see createPart)
+std::vector<Entity> draggedObjects; // object of every sweep, same index
+std::vector<GroupSweep> dragSweeps;
+std::vector<SweepHit> dragHits;
+unsigned long dragImpacts = 0;
+
+// rigid bodies: "--physics" moves the objects with a rigid body step that pushes them apart at the
+// contacts of collisionSystem and bounces them off the window borders
+// a dragged object is kinematic: the step doesn't move it, but its drag velocity pushes the others
+bool physicsEnabled = false;
+PhysicsWorld physics = physicsWorldInit();
+std::vector<ContactPair> bodyContacts; // contacts with physics body indices instead of parts
+const float SIMULATION_STEP = 1.0f / 60.0f;
+
+// animation: "F3" plays a looping keyframe timeline on both objects, starting from where they are
+// the clock advances one simulation step per simulated frame, so a replay animates identically
+// track targets index animationTargets
+Animator animator;
+std::vector<Entity> animationTargets;
+float animationTime = 0.0f;
+bool animationsPlaying = false;
+
 struct ObjectData {
     unsigned int VAO;
     unsigned int VBO;
     unsigned int EBO;
 };
 
-// vertex shader pipeline: calculate the position of vertices
+// structure to store one drawable mesh, referenced by the MeshRef components
+// palette is the figure's default colors, copied into the palette slice of every part drawing it
+// shape optionally describes the same figure for the SDF renderer
+struct Mesh {
+    ObjectData data;
+    unsigned int indexCount;
+    std::vector<glm::vec3> palette;
+    bool hasShape;
+    SdfShape shape;
+};
+std::vector<Mesh> meshes;
+
+// colors: the palette slices of all parts (see the Color components), uploaded once per frame
+Palette palette;
+const int PALETTE_UNIT = 0;
+
+// vertex shader pipeline: calculate the position of vertices (built-in copy of figure.vert)
 const char *vertexShaderSource = "#version 330 core\n"
     "uniform mat4 transform;"
+    "uniform samplerBuffer palette;\n"
+    "uniform int paletteOffset;\n"
     "layout (location = 0) in vec3 vertexPos;\n"
-    "layout (location = 1) in vec3 vertexColor;\n"
+    "layout (location = 1) in float vertexPaletteIndex;\n"
+    "layout (location = 2) in vec3 vertexEdgeDistance;\n"
     "out vec3 fragmentColor;\n"
+    "out vec3 edgeDistance;\n"
     "void main()\n"
     "{\n"
     "   gl_Position = transform * vec4(vertexPos, 1.0f);\n"
-    "   fragmentColor = vertexColor;\n"
+    "   fragmentColor = texelFetch(palette, paletteOffset + int(vertexPaletteIndex)).rgb;\n"
+    "   edgeDistance = vertexEdgeDistance;\n"
     "}\0";
 
-// fragment shader pipeline: calculate the output color
+// fragment shader pipeline: calculate the output color (built-in copy of figure.frag)
+// edge smoothing: fade the outline over one pixel using the distance to the nearest outline edge
 const char* fragmentShaderSource = "#version 330 core\n"
+    "uniform bool edgeSmoothing;\n"
+    "uniform vec3 tint;\n"
     "in vec3 fragmentColor;\n"
+    "in vec3 edgeDistance;\n"
     "out vec4 finalColor;\n"
     "void main()\n"
     "{\n"
-    "   finalColor = vec4 (fragmentColor, 1.0);\n"
+    "   float coverage = 1.0;\n"
+    "   if (edgeSmoothing) {\n"
+    "      vec3 pixels = edgeDistance / max(fwidth(edgeDistance), vec3(1e-6));\n"
+    "      coverage = clamp(min(min(pixels.x, pixels.y), pixels.z), 0.0, 1.0);\n"
+    "   }\n"
+    "   finalColor = vec4 (fragmentColor * tint, coverage);\n"
+    "}\0";
+
+// fallback fragment shader: flat grey, drawn with until the real program has compiled
+const char* fallbackFragmentShaderSource = "#version 330 core\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "   finalColor = vec4 (0.5, 0.5, 0.5, 1.0);\n"
     "}\0";
 
 // initialize the openGL window: specify the GLFW & glad versions and viewpoint
@@ -63,6 +239,7 @@ GLFWwindow* initialization(int width, int height) {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_SAMPLES, msaaSamples);
     
     GLFWwindow* window = glfwCreateWindow(width, height, "OpenGL Window", NULL, NULL);
     if (!window) {
@@ -72,97 +249,298 @@ GLFWwindow* initialization(int width, int height) {
     }
     glfwMakeContextCurrent(window);
 
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+    // function loading: the minimal loader resolves only the entry points the program calls
+    auto loadStart = std::chrono::steady_clock::now();
+#ifdef GLAD_MINIMAL_LOADER
+    int loaded = gladLoadGLLoaderMinimal((GLADloadproc)glfwGetProcAddress);
+#else
+    int loaded = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+#endif
+    if (!loaded) {
         std::cout << "ERROR: Failed to load glad" << std::endl;
         glfwTerminate();
         return NULL;
     }
-    glViewport(0,0, width, height);
+    std::chrono::duration<double, std::milli> loadTime = std::chrono::steady_clock::now() - loadStart;
+    std::cout << "INFO: GL functions loaded in " << loadTime.count() << " ms" << std::endl;
+
+    // blending: smoothed edges write partial coverage into the alpha channel
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (msaaSamples > 0)
+        glEnable(GL_MULTISAMPLE);
 
     return window;
 }
 
-// adjust window size: when the window is resized, edit the window parameters
+// adjust window size: when the window or its framebuffer is resized, rebuild the viewport
+// on the next frame (a drag resize can deliver many sizes between two frames)
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    viewportChanged = true;
+    redraw.dirty = true;
+}
+
+void window_size_callback(GLFWwindow* window, int width, int height) {
+    viewportChanged = true;
+    redraw.dirty = true;
+}
+
+// window refresh function: the window contents were damaged and have to be drawn again
+void window_refresh_callback(GLFWwindow* window) {
+    redraw.dirty = true;
+}
+
+// viewport update: read the current sizes and, if they changed, set the GL viewport (framebuffer
+// pixels) and move the physics bounds to the visible world; returns true when the size changed
+bool updateViewport(GLFWwindow* window) {
+    int windowWidth, windowHeight, framebufferWidth, framebufferHeight;
+    glfwGetWindowSize(window, &windowWidth, &windowHeight);
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    if (!resizeViewport(viewport, windowWidth, windowHeight, framebufferWidth, framebufferHeight))
+        return false;
+
+    glViewport(0, 0, framebufferWidth, framebufferHeight);
+    physics.boundsMin = -viewport.extent;
+    physics.boundsMax = viewport.extent;
+    return true;
+}
+
+// held transform keys: the objects keep changing for as long as one of these is down
+const int transformKeys[] = {
+    GLFW_KEY_UP, GLFW_KEY_DOWN, GLFW_KEY_LEFT, GLFW_KEY_RIGHT, GLFW_KEY_R,
+    GLFW_KEY_COMMA, GLFW_KEY_PERIOD, GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A,
+    GLFW_KEY_D, GLFW_KEY_T, GLFW_KEY_LEFT_BRACKET, GLFW_KEY_RIGHT_BRACKET
+};
+
+// held keys: bit mask with one bit per entry of transformKeys
+uint32_t heldKeys(GLFWwindow* window) {
+    uint32_t keys = 0;
+    for (unsigned int i = 0; i < sizeof(transformKeys) / sizeof(transformKeys[0]); i++) {
+        if (glfwGetKey(window, transformKeys[i]) == GLFW_PRESS)
+            keys |= 1u << i;
+    }
+    return keys;
+}
+
+bool keyHeld(uint32_t keys, int key) {
+    for (unsigned int i = 0; i < sizeof(transformKeys) / sizeof(transformKeys[0]); i++) {
+        if (transformKeys[i] == key)
+            return keys & (1u << i);
+    }
+    return false;
+}
+
+// artificial borders: scale doesn't become negative or too large (keys and mouse wheel)
+// the physics bodies get their mass from the scale, so it has to stay well above zero
+const float MIN_SCALE = 0.5f;
+const float MAX_SCALE = 3.0f;
+
+float clampScale(float scale) {
+    return glm::clamp(scale, MIN_SCALE, MAX_SCALE);
 }
 
-// process user input: query GLFW if a key is pressed on the current frame
-void processInput(GLFWwindow *window) {
+// process user input: apply the keys held on the current frame
+void processInput(GLFWwindow *window, uint32_t keys) {
     // exit the program on "escape" press
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
 
+    Transform2D* one = getComponent<Transform2D>(world, controlledEntities[0]);
+    Transform2D* two = getComponent<Transform2D>(world, controlledEntities[1]);
+    if (!one || !two)
+        return;
+
         // OBJECT ONE
     // translation (Press "up" to move up, "down" to move down, "left" to move left, 
     // and "right" to move right)
-    if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
-        translation.y += 0.01f;
-    if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) 
-        translation.y -= 0.01f;
-    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
-        translation.x -= 0.01f;
-    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
-        translation.x += 0.01f;
+    if (keyHeld(keys, GLFW_KEY_UP))
+        one->position.y += 0.01f;
+    if (keyHeld(keys, GLFW_KEY_DOWN)) 
+        one->position.y -= 0.01f;
+    if (keyHeld(keys, GLFW_KEY_LEFT))
+        one->position.x -= 0.01f;
+    if (keyHeld(keys, GLFW_KEY_RIGHT))
+        one->position.x += 0.01f;
 
     // rotation (Press "r")
-    if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS)
-        rotationSpeed += 0.01f;
+    if (keyHeld(keys, GLFW_KEY_R))
+        one->rotation += 0.01f;
 
     // scaling (Press "," to scale down, "." to scale up)
-    if (glfwGetKey(window, GLFW_KEY_COMMA) == GLFW_PRESS)
-        scaleSpeed -= 0.01f;
-    if (glfwGetKey(window, GLFW_KEY_PERIOD) == GLFW_PRESS)
-        scaleSpeed += 0.01f;
+    if (keyHeld(keys, GLFW_KEY_COMMA))
+        one->scale -= 0.01f;
+    if (keyHeld(keys, GLFW_KEY_PERIOD))
+        one->scale += 0.01f;
+    one->scale = clampScale(one->scale);
 
         // OBJECT TWO
     // translation (Press "W" to move up, "S" to move down, "A" to move left, 
     // and "D" to move right)
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        translation2.y += 0.01f;
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        translation2.y -= 0.01f;
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        translation2.x -= 0.01f;
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        translation2.x += 0.01f;
+    if (keyHeld(keys, GLFW_KEY_W))
+        two->position.y += 0.01f;
+    if (keyHeld(keys, GLFW_KEY_S))
+        two->position.y -= 0.01f;
+    if (keyHeld(keys, GLFW_KEY_A))
+        two->position.x -= 0.01f;
+    if (keyHeld(keys, GLFW_KEY_D))
+        two->position.x += 0.01f;
 
     // rotation (Press "t")
-    if (glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS)
-        rotationSpeed2 += 0.01f;
+    if (keyHeld(keys, GLFW_KEY_T))
+        two->rotation += 0.01f;
 
     // scaling (Press "[" to scale down, "]" to scale up)
-    if (glfwGetKey(window, GLFW_KEY_LEFT_BRACKET) == GLFW_PRESS)
-        scaleSpeed2 -= 0.01f;
-    if (glfwGetKey(window, GLFW_KEY_RIGHT_BRACKET) == GLFW_PRESS)
-        scaleSpeed2 += 0.01f;
+    if (keyHeld(keys, GLFW_KEY_LEFT_BRACKET))
+        two->scale -= 0.01f;
+    if (keyHeld(keys, GLFW_KEY_RIGHT_BRACKET))
+        two->scale += 0.01f;
+    two->scale = clampScale(two->scale);
 }
 
-// mouse button function: tracks mouse click and release
+// mouse button function: queue the mouse click and release
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
-    if (button == GLFW_MOUSE_BUTTON_LEFT) {
-        if (action == GLFW_PRESS) {
-            // mouse press: store the mouse position and determine which object is being dragged
-            isDragging = true;
-            glfwGetCursorPos(window, &lastX, &lastY);
-
-            // Check if the mouse is over one of the objects
-            if (lastX < SCR_WIDTH / 2) {
-                draggedObject = 0;  // Object 1
-            } else {
-                draggedObject = 1;  // Object 2
-            }
-        } 
-        else if (action == GLFW_RELEASE) {
-            // mouse release: stop dragging
-            isDragging = false;
-            draggedObject = -1;
+    if (button != GLFW_MOUSE_BUTTON_LEFT)
+        return;
+
+    InputEvent event;
+    event.type = (action == GLFW_PRESS) ? INPUT_MOUSE_PRESS : INPUT_MOUSE_RELEASE;
+    event.time = glfwGetTime();
+    glfwGetCursorPos(window, &event.x, &event.y);
+    inputQueue.push(event);
+}
+
+// mouse position function: queue the mouse movement
+void mouse_move_callback(GLFWwindow* window, double xpos, double ypos) {
+    inputQueue.push({INPUT_CURSOR_MOVE, glfwGetTime(), xpos, ypos}, INPUT_RESERVE);
+}
+
+// mouse wheel function: queue the mouse wheel scrolling
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
+    inputQueue.push({INPUT_SCROLL, glfwGetTime(), xoffset, yoffset}, INPUT_RESERVE);
+}
+
+// key function: queue key presses that trigger one-off actions (held keys are polled instead)
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    if (action == GLFW_PRESS)
+        inputQueue.push({INPUT_KEY, glfwGetTime(), (double)key, (double)action});
+}
+
+// demo timeline: every curve type on the two objects, relative to their current state
+// object one spins, pulses and glows, object two follows a Catmull-Rom path, swings on a Hermite
+// curve and flashes, roof included
+void startDemoAnimation() {
+    const Transform2D* one = getComponent<Transform2D>(world, animationTargets[0]);
+    const Transform2D* two = getComponent<Transform2D>(world, animationTargets[1]);
+    if (!one || !two)
+        return;
+
+    auto key = [](float time, glm::vec4 value, AnimationCurve curve) {
+        return Keyframe{time, value, glm::vec4(0.0f), curve};
+    };
+    const glm::vec4 white(1.0f), glow(1.0f, 0.8f, 0.4f, 1.0f), flash(0.5f, 0.8f, 1.0f, 1.0f);
+    glm::vec4 position(two->position, 0.0f, 0.0f);
+
+    animator = Animator();
+    addAnimationTrack(animator, 0, CHANNEL_ROTATION, {
+        key(0.0f, glm::vec4(one->rotation), CURVE_SINE_IN_OUT),
+        key(2.0f, glm::vec4(one->rotation + 6.2831853f), CURVE_LINEAR)
+    }, 0.0f, true);
+    addAnimationTrack(animator, 0, CHANNEL_SCALE, {
+        key(0.0f, glm::vec4(one->scale), CURVE_BACK_OUT),
+        key(0.6f, glm::vec4(one->scale * 1.4f), CURVE_BOUNCE_OUT),
+        key(1.4f, glm::vec4(one->scale), CURVE_LINEAR),
+        key(2.0f, glm::vec4(one->scale), CURVE_LINEAR)
+    }, 0.0f, true);
+    addAnimationTrack(animator, 0, CHANNEL_COLOR, {
+        key(0.0f, white, CURVE_QUADRATIC_IN_OUT),
+        key(1.5f, glow, CURVE_CUBIC_OUT),
+        key(3.0f, white, CURVE_LINEAR)
+    }, 0.0f, true);
+    addAnimationTrack(animator, 1, CHANNEL_TRANSLATION, {
+        key(0.0f, position, CURVE_CATMULL_ROM),
+        key(1.0f, position + glm::vec4(0.0f, 0.3f, 0.0f, 0.0f), CURVE_CATMULL_ROM),
+        key(2.0f, position + glm::vec4(-0.3f, 0.2f, 0.0f, 0.0f), CURVE_CATMULL_ROM),
+        key(3.0f, position + glm::vec4(-0.2f, -0.3f, 0.0f, 0.0f), CURVE_CATMULL_ROM),
+        key(4.0f, position, CURVE_CATMULL_ROM)
+    }, 0.0f, true);
+    addAnimationTrack(animator, 1, CHANNEL_ROTATION, {
+        {0.0f, glm::vec4(two->rotation), glm::vec4(0.6f), CURVE_HERMITE},
+        {1.0f, glm::vec4(two->rotation + 0.3f), glm::vec4(0.0f), CURVE_HERMITE},
+        {3.0f, glm::vec4(two->rotation - 0.3f), glm::vec4(0.0f), CURVE_HERMITE},
+        {4.0f, glm::vec4(two->rotation), glm::vec4(0.6f), CURVE_HERMITE}
+    }, 0.0f, true);
+    for (int target = 1; target <= 2; target++) {
+        addAnimationTrack(animator, target, CHANNEL_COLOR, {
+            key(0.0f, white, CURVE_ELASTIC_OUT),
+            key(1.0f, flash, CURVE_LINEAR),
+            key(2.0f, white, CURVE_LINEAR),
+            key(4.0f, white, CURVE_LINEAR)
+        }, 0.0f, true);
+    }
+    animationTime = 0.0f;
+    animationsPlaying = true;
+}
+
+// key press: one-off actions
+void keyPress(int key) {
+    // trace export (Press "F12")
+    if (key == GLFW_KEY_F12 && traceFrames)
+        traceExport(traceFile);
+
+    // pacing mode switch: report the current mode, then use the next one (Press "F4")
+    if (key == GLFW_KEY_F4)
+        cyclePacing = true;
+
+    // decagon renderer switch: mesh or SDF quad (Press "F2")
+    MeshRef* decagonMesh = getComponent<MeshRef>(world, controlledEntities[0]);
+    if (key == GLFW_KEY_F2 && decagonMesh && meshes[decagonMesh->mesh].hasShape) {
+        decagonMesh->sdf = !decagonMesh->sdf;
+        redraw.dirty = true;
+    }
+
+    // demo animation: start it, or stop it where it is (Press "F3")
+    if (key == GLFW_KEY_F3) {
+        if (animationsPlaying) {
+            stopAnimations(animator);
+            animationsPlaying = false;
+        } else {
+            startDemoAnimation();
         }
+        redraw.dirty = true;
     }
 }
 
-// mouse position function: tracks mouse movement during drag
-void mouse_move_callback(GLFWwindow* window, double xpos, double ypos) {
+// mouse press: store the mouse position and determine which object is being dragged
+void mousePress(double xpos, double ypos) {
+    isDragging = true;
+    lastX = xpos;
+    lastY = ypos;
+
+    // Check if the mouse is over one of the objects: the cursor is moved into the local space of
+    // each pickable part and tested against its outline, the hit selects the part's owner
+    // parts are visited in drawing order, so the last hit is the one on top
+    glm::vec4 cursor(cursorToWorld(viewport, lastX, lastY), 0.0f, 1.0f);
+    draggedEntity = NO_ENTITY;
+    forEachChunk(world, componentBit<Transform2D>() | componentBit<Pickable>(), [&](Chunk& chunk) {
+        const Transform2D* transforms = chunkComponents<Transform2D>(chunk);
+        const Pickable* pickables = chunkComponents<Pickable>(chunk);
+        for (int i = 0; i < chunk.count; i++) {
+            glm::vec2 local = glm::vec2(glm::inverse(scene.nodes[transforms[i].node].world) * cursor);
+            const std::vector<glm::vec2>& outline = pickOutlines[pickables[i].outline];
+            if (pointInPolygon(local, outline.data(), (int)outline.size()))
+                draggedEntity = pickables[i].owner;
+        }
+    });
+}
+
+// mouse release: stop dragging
+void mouseRelease() {
+    isDragging = false;
+    draggedEntity = NO_ENTITY;
+}
+
+// mouse movement: move the dragged object by the distance the mouse travelled
+void mouseMove(double xpos, double ypos) {
     if (isDragging) {
         // position calculation: how much the mouse has moved since the last position
         double deltaX = xpos - lastX;
@@ -172,105 +550,156 @@ void mouse_move_callback(GLFWwindow* window, double xpos, double ypos) {
         lastX = xpos;
         lastY = ypos;
 
-        // move the selected object
-        if (draggedObject == 0) {
-            // update translation for object 1 (decagon)
-            translation.x += deltaX / SCR_WIDTH * 2.0f;  // Scale the movement by screen width
-            translation.y -= deltaY / SCR_HEIGHT * 2.0f;  // Scale the movement by screen height
-        }
-        else if (draggedObject == 1) {
-            // update translation for object 2 (house)
-            translation2.x += deltaX / SCR_WIDTH * 2.0f;
-            translation2.y -= deltaY / SCR_HEIGHT * 2.0f;
+        // move the selected object: the motion is added to its sweep for this frame
+        redraw.dirty = true;
+        if (getComponent<Transform2D>(world, draggedEntity)) {
+            glm::vec2 motion = cursorMotionToWorld(viewport, deltaX, deltaY);
+            unsigned int sweep = 0;
+            while (sweep < dragSweeps.size() && dragSweeps[sweep].group != (int)draggedEntity.index)
+                sweep++;
+            if (sweep == dragSweeps.size()) {
+                draggedObjects.push_back(draggedEntity);
+                dragSweeps.push_back({(int)draggedEntity.index, glm::vec2(0.0f)});
+            }
+            dragSweeps[sweep].translation += motion;
         }
     }
 }
 
-// mouse wheel function: tracks mouse wheel scrolling
-void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
+// mouse wheel scrolling: scale both objects
+void mouseScroll(double yoffset) {
+    Transform2D* one = getComponent<Transform2D>(world, controlledEntities[0]);
+    Transform2D* two = getComponent<Transform2D>(world, controlledEntities[1]);
+    if (!one || !two)
+        return;
+
+    redraw.dirty = true;
     if (yoffset > 0) {
-        // scrolled up: increase scale speed
-        scaleSpeed += 0.05f;
-        scaleSpeed2 += 0.05f;
+        // scrolled up: increase scale
+        one->scale += 0.05f;
+        two->scale += 0.05f;
     } else {
-        // scrolled down: decrease scale speed
-        scaleSpeed -= 0.05f;
-        scaleSpeed2 -= 0.05f;
+        // scrolled down: decrease scale
+        one->scale -= 0.05f;
+        two->scale -= 0.05f;
     }
 
-    // artificial borders: scaleSpeed doesn't become negative or too large
-    if (scaleSpeed < -0.5f) scaleSpeed = -0.5f;  // Min scale factor
-    if (scaleSpeed > 2.0f) scaleSpeed = 2.0f;   // Max scale factor
+    one->scale = clampScale(one->scale);
+    two->scale = clampScale(two->scale);
 }
 
-// error generation for wrong shader compilation
-void shaderErrLogger(unsigned int shaderType, const char* name) {
-    int status;
-    char errLog[1024];
+// input drain: move every queued event into the frame, once per frame
+// consecutive cursor moves are coalesced, only the last position of a run is kept
+void drainInput(InputFrame& frame) {
+    frame.events.clear();
+
+    InputEvent event;
+    while (inputQueue.pop(event)) {
+        InputEvent next;
+        if (event.type == INPUT_CURSOR_MOVE) {
+            while (inputQueue.peek(next) && next.type == INPUT_CURSOR_MOVE)
+                inputQueue.pop(event);
+        }
+        frame.events.push_back(event);
+    }
 
-    if (name == "shader") {
-        glGetShaderiv(shaderType, GL_COMPILE_STATUS, &status);
+    unsigned long dropped = inputQueue.dropped();
+    if (dropped != inputDropped) {
+        std::cout << "ERROR: input queue full, " << dropped - inputDropped << " events dropped" << std::endl;
+        inputDropped = dropped;
+    }
+}
 
-        if (!status) {
-            glGetShaderInfoLog(shaderType, 1024, NULL, errLog);
-            std::cout << "ERROR: shader compilation unsuccessful\n" <<
-                errLog << std::endl;
+// input application: apply the events of one frame, live or replayed
+void applyInput(const InputFrame& frame) {
+    for (const InputEvent& event : frame.events) {
+        switch (event.type) {
+            case INPUT_MOUSE_PRESS:
+                mousePress(event.x, event.y);
+                break;
+            case INPUT_MOUSE_RELEASE:
+                mouseRelease();
+                break;
+            case INPUT_CURSOR_MOVE:
+                mouseMove(event.x, event.y);
+                break;
+            case INPUT_SCROLL:
+                mouseScroll(event.y);
+                break;
+            case INPUT_KEY:
+                keyPress((int)event.x);
+                break;
         }
     }
-    else if (name == "program") {
-        glGetProgramiv(shaderType, GL_LINK_STATUS, &status);
+}
 
-        if (!status) {
-            glGetProgramInfoLog(shaderType, 1024, NULL, errLog);
-            std::cout << "ERROR: shader link unsuccessful\n" <<
-                errLog << std::endl;
+// shader hot reload: recompile only the programs built from one of the changed files
+void reloadChangedShaders(ShaderManager& manager, const std::vector<ShaderFiles>& programs,
+        const std::vector<std::string>& changed) {
+    for (const ShaderFiles& files : programs) {
+        bool affected = false;
+        for (const std::string& name : changed)
+            affected = affected || name == files.vertexFile || name == files.fragmentFile;
+        if (!affected)
+            continue;
+
+        std::string vertexSource, fragmentSource;
+        if (!loadShaderFile(shaderDirectory + "/" + files.vertexFile, vertexSource) ||
+                !loadShaderFile(shaderDirectory + "/" + files.fragmentFile, fragmentSource)) {
+            std::cout << "ERROR: could not read " << files.vertexFile << " or " <<
+                files.fragmentFile << std::endl;
+            continue;
         }
+        reloadProgram(manager, files.handle, vertexSource, fragmentSource);
     }
 }
 
-// complete shader generation: generate a program from vertex and fragment shaders
-// both of these shaders are minimal requirements for the program
-unsigned int programGeneration() {
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-    shaderErrLogger(vertexShader, "shader");
-
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-    shaderErrLogger(fragmentShader, "shader");
-
-    unsigned int program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-    shaderErrLogger(program, "program");
-
-    // deprecated shader clease: delete the linked shaders for realocation
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+// state checksum: FNV-1a over the object state, equal checksums mean identical runs
+uint64_t stateChecksum() {
+    float state[8] = {};
+    for (int object = 0; object < 2; object++) {
+        const Transform2D* transform = getComponent<Transform2D>(world, controlledEntities[object]);
+        if (transform) {
+            state[object * 4] = transform->position.x;
+            state[object * 4 + 1] = transform->position.y;
+            state[object * 4 + 2] = transform->rotation;
+            state[object * 4 + 3] = transform->scale;
+        }
+    }
+    const unsigned char* bytes = (const unsigned char*)state;
 
-    return program;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned int i = 0; i < sizeof(state); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
 }
 
 Figure decagonFig() {
     Figure decagon;
     decagon.vertices = {
         // center point of decagon
-         0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
+         0.0f, 0.0f, 0.0f, 0.0f,
         // vertices of the decagon
-        // positions       // colors
-        0.500, 0.000, 0.0,   1.0f, 0.0f, 0.0f,
-        0.405, 0.294, 0.0,   1.0f, 0.5f, 0.0f,
-        0.155, 0.476, 0.0,   1.0f, 1.0f, 0.0f,
-        -0.155, 0.476, 0.0,  0.5f, 1.0f, 0.0f,
-        -0.405, 0.294, 0.0,  0.0f, 1.0f, 0.0f,
-        -0.500, 0.000, 0.0,  0.0f, 1.0f, 0.5f,
-        -0.405, -0.294, 0.0, 0.0f, 0.5f, 1.0f,
-        -0.155, -0.476, 0.0, 0.0f, 0.0f, 1.0f,
-        0.155, -0.476, 0.0,  0.5f, 0.0f, 1.0f,
-        0.405, -0.294, 0.0,  1.0f, 0.0f, 1.0f
+        // positions        // palette index
+        0.500, 0.000, 0.0,   1.0f,
+        0.405, 0.294, 0.0,   2.0f,
+        0.155, 0.476, 0.0,   3.0f,
+        -0.155, 0.476, 0.0,  4.0f,
+        -0.405, 0.294, 0.0,  5.0f,
+        -0.500, 0.000, 0.0,  6.0f,
+        -0.405, -0.294, 0.0, 7.0f,
+        -0.155, -0.476, 0.0, 8.0f,
+        0.155, -0.476, 0.0,  9.0f,
+        0.405, -0.294, 0.0,  10.0f
+    };
+
+    // palette: white center, the rim goes once around the hue wheel
+    decagon.palette = {
+        {1.0f, 1.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f}, {1.0f, 0.5f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.5f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.5f}, {0.0f, 0.5f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.5f, 0.0f, 1.0f}, {1.0f, 0.0f, 1.0f}
     };
 
     // decagon will be created from triangles
@@ -287,29 +716,173 @@ Figure decagonFig() {
         0, 10, 1
     };
 
+    decagon.outline = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
     return decagon;
 }
 
 Figure houseFig() {
     Figure house;
     house.vertices = {
-         // positions       // colors
-         0.5f,  0.5f, 0.0f, 1.0f, 0.5f, 0.2f,  // top right
-         0.5f, -0.5f, 0.0f, 1.0f, 0.5f, 0.2f,  // bottom right
-        -0.5f, -0.5f, 0.0f, 1.0f, 0.5f, 0.2f,  // bottom left
-        -0.5f,  0.5f, 0.0f, 1.0f, 0.5f, 0.2f,  // top left
-        0.0f,  0.75f, 0.0f, 1.0f, 0.5f, 0.2f  // roof
+         // positions       // palette index
+         0.5f,  0.5f, 0.0f, 0.0f,  // top right
+         0.5f, -0.5f, 0.0f, 0.0f,  // bottom right
+        -0.5f, -0.5f, 0.0f, 0.0f,  // bottom left
+        -0.5f,  0.5f, 0.0f, 0.0f   // top left
     };
+    house.palette = {{1.0f, 0.5f, 0.2f}};
 
     house.indices = {
         0, 1, 3,
-        1, 2, 3,
-        0, 3, 4
+        1, 2, 3
     };
 
+    // outline: bottom left, bottom right, top right, top left
+    house.outline = {2, 1, 0, 3};
+
     return house;
 }
 
+// roof: a child of the house body, positioned on its top edge (the roof node's origin)
+// the base reaches slightly below the origin so the body's smoothed top edge stays covered
+Figure roofFig() {
+    Figure roof;
+    roof.vertices = {
+         // positions         // palette index
+         0.5f, -0.02f, 0.0f,  0.0f,  // right
+        -0.5f, -0.02f, 0.0f,  0.0f,  // left
+         0.0f,  0.25f, 0.0f,  0.0f   // top
+    };
+    roof.palette = {{1.0f, 0.5f, 0.2f}};
+
+    roof.indices = {
+        0, 2, 1
+    };
+
+    roof.outline = {1, 0, 2};
+
+    return roof;
+}
+
+// local transform: move the part to its position, then rotate and scale it around its own center
+glm::mat4 localTransform(const Transform2D& transform) {
+    glm::mat4 local = glm::translate(glm::mat4(1.0f), glm::vec3(transform.position, 0.0f));
+    local = glm::rotate(local, transform.rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+    return glm::scale(local, glm::vec3(transform.scale, transform.scale, 1.0f));
+}
+
+// part entity: a drawn, pickable part of an object, owned by itself when owner is NO_ENTITY
+Entity createPart(ComponentMask mask, glm::vec2 position, int node, int mesh, int outline, Entity owner) {
+    Entity entity = createEntity(world, mask);
+    *getComponent<Transform2D>(world, entity) = {position, 0.0f, 1.0f, node};
+    *getComponent<MeshRef>(world, entity) = {mesh, false};
+    *getComponent<Color>(world, entity) = {glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(1.0f, 1.0f, 1.0f),
+        allocatePalette(palette, meshes[mesh].palette)};
+    *getComponent<Pickable>(world, entity) = {outline, owner.generation ? owner : entity};
+    Collider* collider = getComponent<Collider>(world, entity);
+    if (collider)
+        *collider = {outline, (int)(owner.generation ? owner : entity).index};
+    return entity;
+}
+
+// motion system: integrate the velocities, returns true while anything is moving
+bool motionSystem(float dt) {
+    bool moving = false;
+    forEachChunk(world, componentBit<Transform2D>() | componentBit<Velocity>(), [&](Chunk& chunk) {
+        Transform2D* transforms = chunkComponents<Transform2D>(chunk);
+        const Velocity* velocities = chunkComponents<Velocity>(chunk);
+        for (int i = 0; i < chunk.count; i++) {
+            transforms[i].position += velocities[i].linear * dt;
+            transforms[i].rotation += velocities[i].angular * dt;
+            moving = moving || velocities[i].linear != glm::vec2(0.0f) || velocities[i].angular != 0.0f;
+        }
+    });
+    return moving;
+}
+
+// transform system: hand the local transform of every part to its scene graph node
+// unchanged transforms don't dirty the node, so static parts cost no matrix rebuild
+void transformSystem() {
+    forEachChunk(world, componentBit<Transform2D>(), [&](Chunk& chunk) {
+        const Transform2D* transforms = chunkComponents<Transform2D>(chunk);
+        for (int i = 0; i < chunk.count; i++)
+            setLocalTransform(scene, transforms[i].node, localTransform(transforms[i]));
+    });
+    updateWorldTransforms(scene);
+}
+
+// decagon shape: the decagon as an SDF, same size, orientation and colors as the mesh
+SdfShape decagonShape() {
+    SdfShape shape;
+    shape.sides = 10.0f;
+    shape.radius = 0.5f;
+    shape.rounding = 0.0f;
+    shape.rotation = 0.0f;
+    shape.innerColor = glm::vec3(1.0f, 1.0f, 1.0f);
+    shape.outerColor = glm::vec3(1.0f, 0.0f, 0.0f);
+    shape.hueWheel = true;
+    return shape;
+}
+
+// figure outline: the positions of the outline vertices (x and y come first in every vertex)
+std::vector<glm::vec2> figureOutline(const Figure& fig) {
+    std::vector<glm::vec2> outline;
+    for (unsigned int index : fig.outline)
+        outline.push_back(glm::vec2(fig.vertices[index * fig.vertexSize], fig.vertices[index * fig.vertexSize + 1]));
+    return outline;
+}
+
+// edge distance figure: every triangle gets its own three vertices, each carrying its distance to
+// the three edges of the triangle; interpolated, that is the distance of a fragment to each edge
+// edges inside the figure get a large constant distance, so only the outline is smoothed
+Figure edgeDistanceFigure(const Figure& fig) {
+    const float INTERIOR_DISTANCE = 1000.0f;
+
+    // outline edges: consecutive outline vertices, stored both ways round
+    std::vector<std::pair<unsigned int, unsigned int>> outlineEdges;
+    for (unsigned int i = 0; i < fig.outline.size(); i++) {
+        unsigned int a = fig.outline[i], b = fig.outline[(i + 1) % fig.outline.size()];
+        outlineEdges.push_back({a, b});
+        outlineEdges.push_back({b, a});
+    }
+
+    Figure result;
+    result.vertexSize = fig.vertexSize + 3;
+    result.palette = fig.palette;
+    for (unsigned int t = 0; t + 2 < fig.indices.size(); t += 3) {
+        const unsigned int* corner = &fig.indices[t];
+        glm::vec2 p[3];
+        for (int i = 0; i < 3; i++)
+            p[i] = glm::vec2(fig.vertices[corner[i] * fig.vertexSize], fig.vertices[corner[i] * fig.vertexSize + 1]);
+
+        for (int i = 0; i < 3; i++) {
+            // vertex i: position and palette index, then one distance per edge (edge j is opposite corner j)
+            for (unsigned int f = 0; f < fig.vertexSize; f++)
+                result.vertices.push_back(fig.vertices[corner[i] * fig.vertexSize + f]);
+
+            for (int j = 0; j < 3; j++) {
+                unsigned int a = corner[(j + 1) % 3], b = corner[(j + 2) % 3];
+                bool onOutline = false;
+                for (const auto& edge : outlineEdges)
+                    onOutline = onOutline || (edge.first == a && edge.second == b);
+
+                float distance = INTERIOR_DISTANCE;
+                if (onOutline && i != j) {
+                    distance = 0.0f; // corner i lies on edge j
+                } else if (onOutline) {
+                    glm::vec2 edge = p[(j + 2) % 3] - p[(j + 1) % 3];
+                    glm::vec2 toCorner = p[i] - p[(j + 1) % 3];
+                    distance = std::abs(edge.x * toCorner.y - edge.y * toCorner.x) / glm::length(edge);
+                }
+                result.vertices.push_back(distance);
+            }
+            result.indices.push_back(t + i);
+        }
+    }
+    result.outline = fig.outline; // still refers to the original vertices, only used with fig
+    return result;
+}
+
 ObjectData createFigureObject(Figure fig) {
     ObjectData objectData;
     
@@ -326,91 +899,593 @@ ObjectData createFigureObject(Figure fig) {
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, fig.indices.size() * sizeof(unsigned int), 
         fig.indices.data(), GL_DYNAMIC_DRAW);
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    GLsizei stride = fig.vertexSize * sizeof(float);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
     glEnableVertexAttribArray(0);
 
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
+    // edge distances: without them the attribute reads as zero, fully smoothed away
+    if (fig.vertexSize >= 7) {
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+        glEnableVertexAttribArray(2);
+    } else {
+        glVertexAttrib3f(2, 1000.0f, 1000.0f, 1000.0f);
+    }
+
     return objectData;
 }
 
-int main() {
+// collision bodies: every part with a collider at its current world transform
+void gatherCollisionBodies() {
+    collisionBodies.clear();
+    collisionEntities.clear();
+    forEachChunk(world, componentBit<Transform2D>() | componentBit<Collider>(), [&](Chunk& chunk) {
+        const Transform2D* transforms = chunkComponents<Transform2D>(chunk);
+        const Collider* colliders = chunkComponents<Collider>(chunk);
+        for (int i = 0; i < chunk.count; i++) {
+            collisionBodies.push_back({colliders[i].shape, colliders[i].group,
+                scene.nodes[transforms[i].node].world});
+            collisionEntities.push_back(chunk.entities[i]);
+        }
+    });
+}
+
+// drag system: move every dragged object by its collected motion, up to its first impact
+// the sweeps start at the current world transforms, so this runs after transformSystem
+// with physics the object also gets the velocity of the whole motion, which is what it pushes with
+void dragSystem() {
+    Velocity* draggedVelocity = getComponent<Velocity>(world, draggedEntity);
+    if (physicsEnabled && draggedVelocity)
+        *draggedVelocity = {glm::vec2(0.0f), 0.0f};
+    if (dragSweeps.empty())
+        return;
+
+    gatherCollisionBodies();
+    sweepCollisions(collisionWorld, collisionBodies, dragSweeps, dragHits);
+    for (unsigned int i = 0; i < dragSweeps.size(); i++) {
+        Transform2D* dragged = getComponent<Transform2D>(world, draggedObjects[i]);
+        if (dragged)
+            dragged->position += dragSweeps[i].translation * dragHits[i].time;
+        Velocity* velocity = getComponent<Velocity>(world, draggedObjects[i]);
+        if (physicsEnabled && velocity)
+            velocity->linear = dragSweeps[i].translation / SIMULATION_STEP;
+        if (dragHits[i].body >= 0)
+            dragImpacts++;
+    }
+    draggedObjects.clear();
+    dragSweeps.clear();
+    transformSystem();
+}
+
+// collision system: find the overlapping parts and tint every part of the objects involved
+void collisionSystem() {
+    gatherCollisionBodies();
+    detectCollisions(collisionWorld, collisionBodies, contacts);
+    if (!contacts.empty())
+        contactFrames++;
+
+    for (unsigned int body = 0; body < collisionBodies.size(); body++) {
+        bool touching = false;
+        for (const ContactPair& contact : contacts) {
+            touching = touching || collisionBodies[contact.a].group == collisionBodies[body].group ||
+                collisionBodies[contact.b].group == collisionBodies[body].group;
+        }
+        Color* color = getComponent<Color>(world, collisionEntities[body]);
+        if (color)
+            color->tint = touching ? color->base * contactTint : color->base;
+    }
+}
+
+// palette cycle: the rim colors of the decagon turn around it while the animations play
+// only the changed entries of its palette slice are uploaded, the vertex buffer stays as it is
+const float PALETTE_CYCLE_RATE = 5.0f; // rim entries per second
+void cycleDecagonPalette() {
+    const Color* color = getComponent<Color>(world, controlledEntities[0]);
+    const std::vector<glm::vec3>& colors = meshes[0].palette;
+    int rim = (int)colors.size() - 1; // entry 0 is the center
+    if (!color || rim < 1)
+        return;
+    int shift = (int)(animationTime * PALETTE_CYCLE_RATE) % rim;
+    for (int i = 0; i < rim; i++)
+        setPaletteColor(palette, color->palette, 1 + i, colors[1 + (i + shift) % rim]);
+}
+
+// animation system: advance the animation clock and write the animated values into the components
+// returns true while any track is playing
+bool animationSystem(float dt) {
+    if (!animationsPlaying)
+        return false;
+
+    animationTime += dt;
+    animationsPlaying = evaluateAnimations(animator, animationTime) > 0;
+    for (int index : animator.updated) {
+        const AnimationTrack& track = animator.tracks[index];
+        const glm::vec4& value = animator.values[index];
+        Entity target = animationTargets[track.target];
+        Transform2D* transform = getComponent<Transform2D>(world, target);
+        Color* color = getComponent<Color>(world, target);
+        if (track.channel == CHANNEL_TRANSLATION && transform)
+            transform->position = glm::vec2(value);
+        else if (track.channel == CHANNEL_ROTATION && transform)
+            transform->rotation = value.x;
+        else if (track.channel == CHANNEL_SCALE && transform)
+            transform->scale = value.x;
+        else if (track.channel == CHANNEL_COLOR && color)
+            color->base = glm::vec3(value);
+    }
+    cycleDecagonPalette();
+    return true;
+}
+
+// physics system: one rigid body step for the objects, with the contacts of the collision pass
+// the components are the state, the physics bodies a copy for the step; returns true while
+// anything moves, tiny velocities are zeroed so a scene at rest stops redrawing
+bool physicsSystem(float dt) {
+    PhysicsBodies& bodies = physics.bodies;
+    const ComponentMask mask = componentBit<Transform2D>() | componentBit<Velocity>() | componentBit<RigidBody>();
+    forEachChunk(world, mask, [&](Chunk& chunk) {
+        const Transform2D* transforms = chunkComponents<Transform2D>(chunk);
+        const Velocity* velocities = chunkComponents<Velocity>(chunk);
+        const RigidBody* rigidBodies = chunkComponents<RigidBody>(chunk);
+        for (int i = 0; i < chunk.count; i++) {
+            int body = rigidBodies[i].body;
+            float scale = std::max(transforms[i].scale, MIN_SCALE); // animations aren't clamped
+            bool kinematic = isDragging && chunk.entities[i].index == draggedEntity.index &&
+                chunk.entities[i].generation == draggedEntity.generation;
+            bodies.x[body] = transforms[i].position.x;
+            bodies.y[body] = transforms[i].position.y;
+            bodies.angle[body] = transforms[i].rotation;
+            bodies.vx[body] = velocities[i].linear.x;
+            bodies.vy[body] = velocities[i].linear.y;
+            bodies.w[body] = velocities[i].angular;
+            bodies.invMass[body] = kinematic ? 0.0f : 1.0f / (rigidBodies[i].mass * scale * scale);
+            bodies.invInertia[body] = kinematic ? 0.0f : 1.0f / (rigidBodies[i].inertia * scale * scale * scale * scale);
+            bodies.radius[body] = rigidBodies[i].radius * scale;
+        }
+    });
+
+    // contacts: collision bodies are parts, the physics body belongs to the object owning the part
+    bodyContacts.clear();
+    for (const ContactPair& contact : contacts) {
+        const Pickable* partA = getComponent<Pickable>(world, collisionEntities[contact.a]);
+        const Pickable* partB = getComponent<Pickable>(world, collisionEntities[contact.b]);
+        const RigidBody* bodyA = partA ? getComponent<RigidBody>(world, partA->owner) : NULL;
+        const RigidBody* bodyB = partB ? getComponent<RigidBody>(world, partB->owner) : NULL;
+        if (bodyA && bodyB)
+            bodyContacts.push_back({bodyA->body, bodyB->body, contact.normal, contact.depth, contact.point});
+    }
+    physicsStep(physics, bodyContacts, dt);
+
+    bool moving = false;
+    forEachChunk(world, mask, [&](Chunk& chunk) {
+        Transform2D* transforms = chunkComponents<Transform2D>(chunk);
+        Velocity* velocities = chunkComponents<Velocity>(chunk);
+        const RigidBody* rigidBodies = chunkComponents<RigidBody>(chunk);
+        for (int i = 0; i < chunk.count; i++) {
+            int body = rigidBodies[i].body;
+            if (bodies.invMass[body] == 0.0f)
+                continue;
+            glm::vec2 linear(bodies.vx[body], bodies.vy[body]);
+            float angular = bodies.w[body];
+            if (glm::dot(linear, linear) < 1e-6f && std::abs(angular) < 1e-3f) {
+                linear = glm::vec2(0.0f);
+                angular = 0.0f;
+            }
+            transforms[i].position = glm::vec2(bodies.x[body], bodies.y[body]);
+            transforms[i].rotation = bodies.angle[body];
+            velocities[i] = {linear, angular};
+            moving = moving || linear != glm::vec2(0.0f) || angular != 0.0f;
+        }
+    });
+    transformSystem();
+    return moving;
+}
+
+// render system: draw every part with a mesh, parts using the SDF path are added to the batch
+void renderSystem(unsigned int shader, SdfRenderer& sdfRenderer, bool sdfReady) {
+    unsigned int transformLoc = glGetUniformLocation(shader, "transform");
+    unsigned int tintLoc = glGetUniformLocation(shader, "tint");
+    unsigned int paletteOffsetLoc = glGetUniformLocation(shader, "paletteOffset");
+    sdfClear(sdfRenderer);
+
+    ComponentMask required = componentBit<Transform2D>() | componentBit<MeshRef>() | componentBit<Color>();
+    forEachChunk(world, required, [&](Chunk& chunk) {
+        const Transform2D* transforms = chunkComponents<Transform2D>(chunk);
+        const MeshRef* meshRefs = chunkComponents<MeshRef>(chunk);
+        const Color* colors = chunkComponents<Color>(chunk);
+        for (int i = 0; i < chunk.count; i++) {
+            const Mesh& mesh = meshes[meshRefs[i].mesh];
+            glm::mat4 transform = viewport.projection * scene.nodes[transforms[i].node].world;
+            if (meshRefs[i].sdf && mesh.hasShape && sdfReady) {
+                SdfShape shape = mesh.shape;
+                shape.innerColor *= colors[i].tint;
+                shape.outerColor *= colors[i].tint;
+                sdfAddShape(sdfRenderer, transform, shape);
+                continue;
+            }
+
+            // pass the transformation matrix, the tint and the palette slice to the shader
+            glUniformMatrix4fv(transformLoc, 1, GL_FALSE, &transform[0][0]);
+            glUniform3fv(tintLoc, 1, &colors[i].tint[0]);
+            glUniform1i(paletteOffsetLoc, colors[i].palette);
+            glBindVertexArray(mesh.data.VAO);
+            glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
+        }
+    });
+}
+
+int main(int argc, char** argv) {
+    // command line: "--record <file>" writes the input to file, "--replay <file>" plays it back,
+    // "--capture <directory>" and "--capture-video <file>" save the rendered frames,
+    // "--golden <directory>" compares the captured frames against stored images,
+    // "--msaa <samples>" and "--no-edge-smoothing" switch the anti-aliasing for comparisons,
+    // "--pacing vsync|novsync|adaptive|cap=<fps>" selects the frame pacing mode,
+    // "--shaders <directory>" reads the shader files from directory,
+    // "--trace <file>" records the frame timeline into file as Chrome trace JSON,
+    // "--sdf" draws the decagon with the SDF renderer, "--physics" runs the rigid body simulation
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--no-edge-smoothing") == 0)
+            edgeSmoothing = false;
+        if (std::strcmp(argv[i], "--sdf") == 0)
+            decagonAsSdf = true;
+        if (std::strcmp(argv[i], "--physics") == 0)
+            physicsEnabled = true;
+        if (i + 1 >= argc)
+            break;
+
+        if (std::strcmp(argv[i], "--record") == 0) {
+            inputSource = INPUT_SOURCE_RECORD;
+            inputLogFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0) {
+            inputSource = INPUT_SOURCE_REPLAY;
+            inputLogFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--capture") == 0) {
+            captureDirectory = argv[++i];
+        } else if (std::strcmp(argv[i], "--capture-video") == 0) {
+            captureVideo = argv[++i];
+        } else if (std::strcmp(argv[i], "--golden") == 0) {
+            goldenDirectory = argv[++i];
+        } else if (std::strcmp(argv[i], "--msaa") == 0) {
+            msaaSamples = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--trace") == 0) {
+            traceFrames = true;
+            traceFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--shaders") == 0) {
+            shaderDirectory = argv[++i];
+        } else if (std::strcmp(argv[i], "--pacing") == 0) {
+            if (!parsePacingMode(argv[++i], pacingMode, targetFps))
+                std::cout << "ERROR: unknown pacing mode " << argv[i] << ", using " <<
+                    pacingModeName(pacingMode, targetFps) << std::endl;
+        }
+    }
+
+    // shader directory: without one, only the built-in sources are used and nothing is watched
+    if (shaderDirectory.empty())
+        shaderDirectory = findShaderDirectory(argv[0]);
+    if (shaderDirectory.empty() || !std::filesystem::is_directory(shaderDirectory)) {
+        std::cout << "ERROR: shader directory " << (shaderDirectory.empty() ? "not found" : shaderDirectory +
+            " does not exist") << ", using the built-in shaders without hot reload" << std::endl;
+        shaderDirectory.clear();
+        shaderHotReload = false;
+    } else {
+        std::cout << "INFO: shaders from " << shaderDirectory << std::endl;
+    }
+
+    // startup timing: measured from here to the first presented frame
+    auto startTime = std::chrono::steady_clock::now();
+
     GLFWwindow* window = initialization(SCR_WIDTH, SCR_HEIGHT);
     if (!window) {
         glfwTerminate();
         return -1;
     }
+    updateViewport(window);
     
     // generate vertex & fragment shaders, combine into a complete shader
-    unsigned int shader = programGeneration();
-
-    // initialize figures
-    Figure decagon = decagonFig();
-    ObjectData decagonData = createFigureObject(decagon);
+    // the real program compiles in the background, the small fallback is finished right away
+    // shader sources: the file, or the built-in copy when it can't be read
+    auto shaderSource = [](const std::string& name, const char* builtIn) {
+        std::string source = builtIn;
+        if (!shaderDirectory.empty() && !loadShaderFile(shaderDirectory + "/" + name, source))
+            std::cout << "INFO: " << shaderDirectory << "/" << name << " not readable, using the built-in source" << std::endl;
+        return source;
+    };
+    std::string vertexSource = shaderSource("figure.vert", vertexShaderSource);
+    std::string fragmentSource = shaderSource("figure.frag", fragmentShaderSource);
+
+    ShaderManager shaders = shaderManagerInit();
+    int fallbackShader = submitProgram(shaders, vertexShaderSource, fallbackFragmentShaderSource);
+    int mainShader = submitProgram(shaders, vertexSource.c_str(), fragmentSource.c_str());
+    waitProgram(shaders, fallbackShader);
+
+    // SDF program: until it is ready, SDF objects are drawn as meshes
+    std::string sdfVertexSource = shaderSource("sdf_shape.vert", sdfVertexShaderSource);
+    std::string sdfFragmentSource = shaderSource("sdf_shape.frag", sdfFragmentShaderSource);
+    int sdfShader = submitProgram(shaders, sdfVertexSource.c_str(), sdfFragmentSource.c_str());
+
+    // shader watch: the files every reloadable program is built from
+    std::vector<ShaderFiles> shaderFiles = {
+        {mainShader, "figure.vert", "figure.frag"},
+        {sdfShader, "sdf_shape.vert", "sdf_shape.frag"}
+    };
+    ShaderWatcher shaderWatcher = watcherInit(shaderDirectory);
+    for (const ShaderFiles& files : shaderFiles) {
+        watchFile(shaderWatcher, files.vertexFile);
+        watchFile(shaderWatcher, files.fragmentFile);
+    }
+    std::vector<std::string> changedShaders;
+
+    // initialize figures: one mesh and one picking outline each
+    paletteInit(palette);
+    const Figure figures[] = {decagonFig(), houseFig(), roofFig()};
+    for (const Figure& figure : figures) {
+        Figure smoothed = edgeDistanceFigure(figure);
+        meshes.push_back({createFigureObject(smoothed), (unsigned int)smoothed.indices.size(), smoothed.palette,
+            false, {}});
+        pickOutlines.push_back(figureOutline(figure));
+        addCollisionShape(collisionWorld, pickOutlines.back());
+    }
+    meshes[0].hasShape = true;
+    meshes[0].shape = decagonShape();
+
+    // scene graph: the roof is attached to the house body and follows it
+    // world transforms are only rebuilt for the subtrees whose local transform changed
+    int decagonNode = addSceneNode(scene, -1, glm::mat4(1.0f));
+    int houseNode = addSceneNode(scene, -1, glm::mat4(1.0f));
+    int roofNode = addSceneNode(scene, houseNode, glm::mat4(1.0f));
+
+    // entities: both objects can move, the roof only follows the house
+    const ComponentMask partMask = componentBit<Transform2D>() | componentBit<MeshRef>() |
+        componentBit<Color>() | componentBit<Pickable>() | componentBit<Collider>();
+    const ComponentMask objectMask = partMask | componentBit<Velocity>() | componentBit<RigidBody>();
+    controlledEntities[0] = createPart(objectMask, decagonOrigin, decagonNode, 0, 0, NO_ENTITY);
+    controlledEntities[1] = createPart(objectMask, houseOrigin, houseNode, 1, 1, NO_ENTITY);
+    Entity roofEntity = createPart(partMask, glm::vec2(0.0f, 0.5f), roofNode, 2, 2, controlledEntities[1]);
+    animationTargets = {controlledEntities[0], controlledEntities[1], roofEntity};
+    getComponent<MeshRef>(world, controlledEntities[0])->sdf = decagonAsSdf;
+
+    // rigid bodies: mass and bounds of every part of an object, about the object origin
+    // (the roof sits at its offset in the house), at density 1
+    auto outlineRadius = [](const std::vector<glm::vec2>& outline, glm::vec2 offset) {
+        float radius = 0.0f;
+        for (const glm::vec2& point : outline)
+            radius = std::max(radius, glm::length(point + offset));
+        return radius;
+    };
+    MassProperties decagonMass = polygonMass(pickOutlines[0], glm::vec2(0.0f));
+    MassProperties houseMass = polygonMass(pickOutlines[1], glm::vec2(0.0f));
+    MassProperties roofMass = polygonMass(pickOutlines[2], glm::vec2(0.0f, 0.5f));
+    houseMass = {houseMass.mass + roofMass.mass, houseMass.inertia + roofMass.inertia};
+    const MassProperties objectMasses[2] = {decagonMass, houseMass};
+    const float objectRadii[2] = {outlineRadius(pickOutlines[0], glm::vec2(0.0f)),
+        std::max(outlineRadius(pickOutlines[1], glm::vec2(0.0f)), outlineRadius(pickOutlines[2], glm::vec2(0.0f, 0.5f)))};
+    for (int i = 0; i < 2; i++) {
+        int body = addPhysicsBody(physics, getComponent<Transform2D>(world, controlledEntities[i])->position,
+            0.0f, objectMasses[i].mass, objectMasses[i].inertia, 0.5f, objectRadii[i]);
+        *getComponent<RigidBody>(world, controlledEntities[i]) = {body, objectMasses[i].mass,
+            objectMasses[i].inertia, objectRadii[i]};
+    }
 
-    Figure house = houseFig();
-    ObjectData houseData = createFigureObject(house);
+    SdfRenderer sdfRenderer;
+    sdfRendererInit(sdfRenderer);
 
     glfwSetMouseButtonCallback(window, mouse_button_callback);
     glfwSetCursorPosCallback(window, mouse_move_callback);
     // Set the scroll callback function
     glfwSetScrollCallback(window, scroll_callback);
+    glfwSetWindowRefreshCallback(window, window_refresh_callback);
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetWindowSizeCallback(window, window_size_callback);
+    glfwSetKeyCallback(window, key_callback);
+
+    // input log: a replay renders every tick, there is no idle time to wait through
+    InputLog inputLog;
+    InputFrame inputFrame = {};
+    if (inputSource == INPUT_SOURCE_RECORD && !openInputRecording(inputLog, inputLogFile))
+        inputSource = INPUT_SOURCE_LIVE;
+    if (inputSource == INPUT_SOURCE_REPLAY) {
+        if (!openInputReplay(inputLog, inputLogFile)) {
+            glfwTerminate();
+            return -1;
+        }
+        redraw.onDemand = false;
+    }
+    traceEnabled = traceFrames;
+
+    // frame pacing: set the swap interval and start measuring frame intervals
+    FramePacer pacer = pacerInit(pacingMode, targetFps);
+
+    // pass timing: CPU submission time and GPU execution time of every render pass
+    GpuTimer gpuTimer;
+    gpuTimerInit(gpuTimer);
+
+    // frame capture: read back at the framebuffer size, which differs from the window size on HiDPI
+    FrameCapture capture;
+    bool capturing = false;
+    if (captureVideo)
+        capturing = captureInitFfmpeg(capture, viewport.framebufferWidth, viewport.framebufferHeight, captureVideo);
+    else if (captureDirectory)
+        capturing = captureInitFiles(capture, viewport.framebufferWidth, viewport.framebufferHeight, captureDirectory);
 
     // main loop: take action until the window is terminated
     while (!glfwWindowShouldClose(window)) {
-        // user input
-        processInput(window);
+        // register events: button click, mouse drag etc.
+        // when idle, sleep until something happens instead of spinning
+        traceBegin("wait");
+        if (redrawIdle(redraw)) {
+            // shaders still compiling: wake up regularly to check on them
+            // shader files watched: wake up a few times a second to look for edits
+            if (programsPending(shaders))
+                glfwWaitEventsTimeout(0.01);
+            else if (shaderHotReload)
+                glfwWaitEventsTimeout(0.25);
+            else
+                glfwWaitEvents();
+            pacerIdle(pacer);
+        }
+        else
+            glfwPollEvents();
+        traceEnd();
+
+        // window size: only a size that actually changed rebuilds the size dependent state,
+        // before the input of this frame is mapped to the world with it
+        if (viewportChanged) {
+            viewportChanged = false;
+            if (updateViewport(window) && capturing)
+                captureResize(capture, viewport.framebufferWidth, viewport.framebufferHeight);
+        }
+
+        // user input: apply queued mouse events, then poll the keyboard
+        traceBegin("input");
+        drainInput(inputFrame);
+        // the input is tagged with the simulated tick it comes before, a replay simulates every
+        // tick (also those without input) and applies each recorded input before the same tick
+        if (inputSource == INPUT_SOURCE_REPLAY) {
+            // replay: live mouse and keys are ignored, the recording ending ends the program
+            readInputTick(inputLog, (uint32_t)redraw.frames, inputFrame);
+            if (inputLog.ended)
+                glfwSetWindowShouldClose(window, true);
+        } else {
+            inputFrame.tick = (uint32_t)redraw.frames;
+            inputFrame.time = (float)glfwGetTime();
+            inputFrame.keys = heldKeys(window);
+            if (inputSource == INPUT_SOURCE_RECORD)
+                writeInputFrame(inputLog, inputFrame);
+        }
+        applyInput(inputFrame);
+        processInput(window, inputFrame.keys);
+        traceEnd();
+
+        // replay end: the last input is applied, the recording stopped before simulating more
+        if (inputSource == INPUT_SOURCE_REPLAY && inputLog.ended)
+            continue;
+
+        // pacing switch: the statistics of the mode so far are printed, the next mode starts fresh
+        if (cyclePacing) {
+            cyclePacing = false;
+            pacerReport(pacer);
+            pacingMode = (PacingMode)((pacingMode + 1) % (PACING_FPS_CAP + 1));
+            pacerSetMode(pacer, pacingMode, targetFps);
+            std::cout << "INFO: frame pacing switched to " << pacingModeName(pacer.mode, targetFps) << std::endl;
+        }
+
+        // shader compilation: start recompiling edited programs, swap in programs as they finish
+        traceBegin("shaders");
+        if (shaderHotReload && pollShaderChanges(shaderWatcher, changedShaders))
+            reloadChangedShaders(shaders, shaderFiles, changedShaders);
+        bool programsChanged = pollPrograms(shaders);
+        traceEnd();
+
+        // nothing changed: keep the frame that is already on screen
+        if (!redrawDecide(redraw, inputFrame.keys != 0, programsChanged))
+            continue;
+        traceBegin("frame");
+
+        // updating the matrices: update transformation matrices of both objects per each frame
+        traceBegin("simulate");
+        // motion: a fixed step per frame, so a replay moves exactly like the recording
+        // with physics the rigid body step moves the objects instead, once the contacts are known
+        bool moving = animationSystem(SIMULATION_STEP);
+        if (!physicsEnabled)
+            moving = motionSystem(SIMULATION_STEP) || moving;
+        transformSystem();
+        dragSystem();
+        collisionSystem();
+        if (physicsEnabled)
+            moving = physicsSystem(SIMULATION_STEP) || moving;
+        redrawFrameDone(redraw, moving);
+        traceEnd();
 
         // frame generation: generate the colored frame after frame clear
+        traceBegin("submit");
+        beginPass(gpuTimer, PASS_CLEAR);
         glClearColor(0.05f, 0.008f, 0.004f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
+        endPass(gpuTimer, PASS_CLEAR);
 
-        // check for the screen size change
-        glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-
+        beginPass(gpuTimer, PASS_OBJECTS);
+        unsigned int shader = programFor(shaders, mainShader, fallbackShader);
         glUseProgram(shader);
 
-        // updating the matrices: update transformation matrices of object one per each frame
-        glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(-0.5f, 0.0f, 0.0f));
-        transform = glm::translate(transform, translation);
-        transform = glm::rotate(transform, rotationSpeed, glm::vec3(0.0f, 0.0f, 1.0f));
-        transform = glm::scale(transform, glm::vec3(1.0f + scaleSpeed, 1.0f + scaleSpeed, 1.0f));
-        
-        // pass the transformation matrix to the shader
-        unsigned int transformLoc = glGetUniformLocation(shader, "transform");
-        glUniformMatrix4fv(transformLoc, 1, GL_FALSE, &transform[0][0]);
-
-        // drawing the first object: decagon
-        glBindVertexArray(decagonData.VAO);
-        glDrawElements(GL_TRIANGLES, decagon.indices.size(), GL_UNSIGNED_INT, 0);
-
-        // updating the matrices: update transformation matrices of object two per each frame
-        glm::mat4 transform2 = glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, 0.0f, 0.0f));;
-        transform2 = glm::translate(transform2, translation2);
-        transform2 = glm::rotate(transform2, rotationSpeed2, glm::vec3(0.0f, 0.0f, 1.0f));
-        transform2 = glm::scale(transform2, glm::vec3(1.0f + scaleSpeed2, 1.0f + scaleSpeed2, 1.0f));
-
-        // pass the transformation matrix to the shader
-        unsigned int transform2Loc = glGetUniformLocation(shader, "transform");
-        glUniformMatrix4fv(transform2Loc, 1, GL_FALSE, &transform2[0][0]);
-
-        // drawing the second object: house
-        glBindVertexArray(houseData.VAO);
-        glDrawElements(GL_TRIANGLES, house.indices.size(), GL_UNSIGNED_INT, 0);
+        glUniform1i(glGetUniformLocation(shader, "edgeSmoothing"), edgeSmoothing);
+        glUniform1i(glGetUniformLocation(shader, "palette"), PALETTE_UNIT);
+        uploadPalette(palette);
+        bindPalette(palette, PALETTE_UNIT);
+
+        // SDF objects are collected into one instanced batch, drawn after the meshes
+        bool sdfReady = shaders.programs[sdfShader].ready;
+        renderSystem(shader, sdfRenderer, sdfReady);
+
+        if (sdfReady && !sdfRenderer.instances.empty()) {
+            unsigned int sdfProgram = programFor(shaders, sdfShader, sdfShader);
+            glUseProgram(sdfProgram);
+            glUniform1i(glGetUniformLocation(sdfProgram, "edgeSmoothing"), edgeSmoothing);
+            sdfDraw(sdfRenderer, sdfProgram);
+        }
+        endPass(gpuTimer, PASS_OBJECTS);
+        gpuTimerFrameEnd(gpuTimer);
+        traceEnd();
+
+        if (capturing) {
+            traceBegin("capture");
+            captureFrame(capture);
+            traceEnd();
+        }
 
-        // register events: button click, mouse drag etc.
-        glfwPollEvents();
         // frame buffering: swap finished frame to process the next
+        traceBegin("swap");
+        pacerWait(pacer);
         glfwSwapBuffers(window);
+        pacerFrameDone(pacer);
+        traceEnd();
+        traceEnd();
+
+        if (redraw.frames == 1) {
+            std::chrono::duration<double, std::milli> firstFrame = std::chrono::steady_clock::now() - startTime;
+            std::cout << "INFO: time to first frame " << firstFrame.count() << " ms" << std::endl;
+        }
+    }
+    if (inputSource == INPUT_SOURCE_RECORD)
+        endInputRecording(inputLog, (uint32_t)redraw.frames);
+    if (inputSource != INPUT_SOURCE_LIVE) {
+        std::cout << "INFO: " << inputLog.frames << " input records over " << redraw.frames << " ticks " <<
+            (inputSource == INPUT_SOURCE_RECORD ? "recorded" : "replayed") << ", state checksum " <<
+            std::hex << stateChecksum() << std::dec << std::endl;
+        closeInputLog(inputLog);
     }
+    std::cout << "INFO: rendered " << redraw.frames << " frames in " <<
+        redraw.iterations << " loop iterations, " << contactFrames << " with contacts, " <<
+        dragImpacts << " drags stopped at an impact" << std::endl;
+    pacerReport(pacer);
+    gpuTimerReport(gpuTimer);
+    gpuTimerDelete(gpuTimer);
+    if (capturing)
+        captureFinish(capture);
+
+    // golden comparison: the exit code reports the result, so scripts can run scene after scene
+    int goldenFailures = 0;
+    if (goldenDirectory && capturing && captureDirectory && !captureVideo)
+        goldenFailures = compareWithGolden(captureDirectory, goldenDirectory, goldenTolerance,
+            goldenMaxBadFraction);
+    else if (goldenDirectory)
+        std::cout << "ERROR: --golden needs --capture <directory>" << std::endl;
+    if (traceFrames)
+        traceExport(traceFile);
+
     // buffer cleanse: delete deprecated buffers before termination
-    glDeleteVertexArrays(1, &decagonData.VAO);
-    glDeleteBuffers(1, &decagonData.VBO);
-    glDeleteBuffers(1, &decagonData.EBO);
+    for (const Mesh& mesh : meshes) {
+        glDeleteVertexArrays(1, &mesh.data.VAO);
+        glDeleteBuffers(1, &mesh.data.VBO);
+        glDeleteBuffers(1, &mesh.data.EBO);
+    }
+    sdfRendererDelete(sdfRenderer);
+    paletteDelete(palette);
     // shader cleanse: delete the program/shader before termination
-    glDeleteProgram(shader);
+    deleteShaderPrograms(shaders);
+    watcherClose(shaderWatcher);
     // program is terminated: program resources are freed and realocated
     glfwTerminate();
-    return 0;
+    return goldenFailures ? 1 : 0;
 }
\ No newline at end of file
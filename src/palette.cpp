@@ -0,0 +1,67 @@
+#include "palette.h"
+
+#include <glad/glad.h>
+
+void paletteInit(Palette& palette) {
+    palette.capacity = 0;
+    palette.colors.clear();
+    palette.dirtyBegin = 0;
+    palette.dirtyEnd = 0;
+
+    glGenBuffers(1, &palette.buffer);
+    glGenTextures(1, &palette.texture);
+}
+
+int allocatePalette(Palette& palette, const std::vector<glm::vec3>& colors) {
+    int offset = (int)palette.colors.size();
+    for (const glm::vec3& color : colors)
+        palette.colors.push_back(glm::vec4(color, 1.0f));
+    if (palette.dirtyBegin == palette.dirtyEnd)
+        palette.dirtyBegin = offset;
+    palette.dirtyEnd = palette.colors.size();
+    return offset;
+}
+
+void setPaletteColor(Palette& palette, int offset, int index, glm::vec3 color) {
+    std::size_t entry = offset + index;
+    if (glm::vec3(palette.colors[entry]) == color)
+        return;
+    palette.colors[entry] = glm::vec4(color, 1.0f);
+    if (palette.dirtyBegin == palette.dirtyEnd) {
+        palette.dirtyBegin = entry;
+        palette.dirtyEnd = entry + 1;
+    } else {
+        palette.dirtyBegin = entry < palette.dirtyBegin ? entry : palette.dirtyBegin;
+        palette.dirtyEnd = entry + 1 > palette.dirtyEnd ? entry + 1 : palette.dirtyEnd;
+    }
+}
+
+void uploadPalette(Palette& palette) {
+    if (palette.dirtyBegin == palette.dirtyEnd)
+        return;
+
+    // growing: reallocate with room to spare and send everything, the texture has to be
+    // attached again to the new storage
+    glBindBuffer(GL_TEXTURE_BUFFER, palette.buffer);
+    if (palette.colors.size() > palette.capacity) {
+        palette.capacity = palette.colors.size() * 2;
+        glBufferData(GL_TEXTURE_BUFFER, palette.capacity * sizeof(glm::vec4), NULL, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, palette.colors.size() * sizeof(glm::vec4), palette.colors.data());
+        glBindTexture(GL_TEXTURE_BUFFER, palette.texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, palette.buffer);
+    } else {
+        glBufferSubData(GL_TEXTURE_BUFFER, palette.dirtyBegin * sizeof(glm::vec4),
+            (palette.dirtyEnd - palette.dirtyBegin) * sizeof(glm::vec4), &palette.colors[palette.dirtyBegin]);
+    }
+    palette.dirtyBegin = palette.dirtyEnd = 0;
+}
+
+void bindPalette(const Palette& palette, int unit) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_BUFFER, palette.texture);
+}
+
+void paletteDelete(Palette& palette) {
+    glDeleteTextures(1, &palette.texture);
+    glDeleteBuffers(1, &palette.buffer);
+}
@@ -0,0 +1,41 @@
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// structure to store the colors of every drawn object in one buffer, read by the figure shader
+// through a buffer texture: a vertex carries an index into its object's palette, the object an
+// offset to the start of its palette (a slice of the buffer)
+// recoloring an object rewrites a few entries of its slice, the vertex buffers never change;
+// the entries changed since the last upload are the range dirtyBegin up to dirtyEnd
+struct Palette {
+    unsigned int buffer;
+    unsigned int texture;
+    std::size_t capacity; // entries the buffer currently holds
+    std::vector<glm::vec4> colors;
+    std::size_t dirtyBegin;
+    std::size_t dirtyEnd;
+};
+
+// palette setup: create the buffer and its texture, needs a current context
+void paletteInit(Palette& palette);
+
+// slice allocation: append a slice holding the given colors, returns its offset
+int allocatePalette(Palette& palette, const std::vector<glm::vec3>& colors);
+
+// recoloring: set entry index of the slice at offset
+void setPaletteColor(Palette& palette, int offset, int index, glm::vec3 color);
+
+// upload: send the changed entries to the buffer (all of them after it had to grow)
+void uploadPalette(Palette& palette);
+
+// binding: attach the palette texture to a texture unit, for the sampler of the shader
+void bindPalette(const Palette& palette, int unit);
+
+// palette cleanse: delete the texture and the buffer
+void paletteDelete(Palette& palette);
+
+#endif
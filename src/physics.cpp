@@ -0,0 +1,357 @@
+#include "physics.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+// position correction: the overlap left alone (so resting contacts don't jitter) and the fraction
+// of the rest that is removed per step
+const float CONTACT_SLOP = 0.005f;
+const float CORRECTION_RATE = 0.2f;
+
+// restitution: slower approaches than this don't bounce, so resting bodies come to rest
+const float BOUNCE_THRESHOLD = 0.1f;
+
+// colors: a body keeps its colors in a 32-bit mask, constraints that find none free are solved
+// serially; threads only pay off with enough batches per color to share
+const int MAX_COLORS = 32;
+const int BATCHES_PER_THREAD = 32;
+
+PhysicsWorld physicsWorldInit() {
+    PhysicsWorld world;
+    world.gravity = glm::vec2(0.0f);
+    world.boundsMin = glm::vec2(-1.0f);
+    world.boundsMax = glm::vec2(1.0f);
+    world.linearDamping = 0.5f;
+    world.angularDamping = 0.5f;
+    world.friction = 0.3f;
+    world.iterations = 8;
+    world.threads = 0;
+    world.constraints.serialColor = false;
+    addPhysicsBody(world, glm::vec2(0.0f), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+    return world;
+}
+
+MassProperties polygonMass(const std::vector<glm::vec2>& outline, glm::vec2 offset) {
+    // triangle fan from the origin: signed area and second moment of every triangle
+    float area = 0.0f, moment = 0.0f;
+    for (unsigned int i = 0, j = outline.size() - 1; i < outline.size(); j = i++) {
+        glm::vec2 p = outline[j] + offset, q = outline[i] + offset;
+        float twice = p.x * q.y - p.y * q.x;
+        area += twice * 0.5f;
+        moment += twice * (glm::dot(p, p) + glm::dot(p, q) + glm::dot(q, q)) / 12.0f;
+    }
+    return {std::abs(area), std::abs(moment)};
+}
+
+int addPhysicsBody(PhysicsWorld& world, glm::vec2 position, float angle, float mass, float inertia,
+        float restitution, float radius) {
+    PhysicsBodies& bodies = world.bodies;
+    bodies.x.push_back(position.x);
+    bodies.y.push_back(position.y);
+    bodies.angle.push_back(angle);
+    bodies.vx.push_back(0.0f);
+    bodies.vy.push_back(0.0f);
+    bodies.w.push_back(0.0f);
+    bodies.invMass.push_back(mass > 0.0f ? 1.0f / mass : 0.0f);
+    bodies.invInertia.push_back(inertia > 0.0f ? 1.0f / inertia : 0.0f);
+    bodies.restitution.push_back(restitution);
+    bodies.radius.push_back(radius);
+    return (int)bodies.x.size() - 1;
+}
+
+static bool isDynamic(const PhysicsBodies& bodies, int body) {
+    return bodies.invMass[body] > 0.0f || bodies.invInertia[body] > 0.0f;
+}
+
+// coloring: greedy, the lowest color neither dynamic body of a contact has taken yet
+// static bodies never change during the solve, so any number of constraints of a color share them
+static void colorContacts(PhysicsWorld& world, const std::vector<ContactPair>& contacts) {
+    const PhysicsBodies& bodies = world.bodies;
+    world.bodyColors.assign(bodies.x.size(), 0);
+    world.contactColors.resize(contacts.size());
+    for (unsigned int i = 0; i < contacts.size(); i++) {
+        const ContactPair& contact = contacts[i];
+        uint32_t taken = 0;
+        if (isDynamic(bodies, contact.a))
+            taken |= world.bodyColors[contact.a];
+        if (isDynamic(bodies, contact.b))
+            taken |= world.bodyColors[contact.b];
+
+        int color = 0;
+        while (color < MAX_COLORS && (taken & (1u << color)))
+            color++;
+        world.contactColors[i] = color;
+        if (color < MAX_COLORS) {
+            world.bodyColors[contact.a] |= 1u << color;
+            world.bodyColors[contact.b] |= 1u << color;
+        }
+    }
+}
+
+// constraint setup: effective masses, lever arms and target velocity of every contact, stored in
+// color order and padded to whole batches; a padding lane uses the static body 0 and zero masses,
+// so its impulse is always zero
+static void prepareConstraints(PhysicsWorld& world, const std::vector<ContactPair>& contacts, float dt) {
+    const PhysicsBodies& bodies = world.bodies;
+    ContactConstraints& c = world.constraints;
+    colorContacts(world, contacts);
+
+    int colorCounts[MAX_COLORS + 1] = {};
+    for (int color : world.contactColors)
+        colorCounts[color]++;
+
+    int colors = 0;
+    for (int color = 0; color < MAX_COLORS; color++) {
+        if (colorCounts[color])
+            colors = color + 1;
+    }
+    c.serialColor = colorCounts[MAX_COLORS] > 0;
+    if (c.serialColor)
+        colors = MAX_COLORS + 1;
+
+    c.colorStart.assign(colors + 1, 0);
+    for (int color = 0; color < colors; color++) {
+        int batches = color == MAX_COLORS ? colorCounts[color] :
+            (colorCounts[color] + PHYSICS_LANES - 1) / PHYSICS_LANES;
+        c.colorStart[color + 1] = c.colorStart[color] + batches;
+    }
+
+    int lanes = c.colorStart[colors] * PHYSICS_LANES;
+    c.bodyA.assign(lanes, 0);
+    c.bodyB.assign(lanes, 0);
+    for (std::vector<float>* column : {&c.normalX, &c.normalY, &c.armAX, &c.armAY, &c.armBX, &c.armBY,
+            &c.normalMass, &c.tangentMass, &c.bias, &c.friction, &c.normalImpulse, &c.tangentImpulse})
+        column->assign(lanes, 0.0f);
+
+    std::vector<int> fill(colors);
+    for (int color = 0; color < colors; color++)
+        fill[color] = c.colorStart[color] * PHYSICS_LANES;
+
+    for (unsigned int i = 0; i < contacts.size(); i++) {
+        const ContactPair& contact = contacts[i];
+        int color = world.contactColors[i];
+        int lane = fill[color];
+        fill[color] += color == MAX_COLORS ? PHYSICS_LANES : 1;
+
+        int a = contact.a, b = contact.b;
+        glm::vec2 n = contact.normal, t(-n.y, n.x);
+        glm::vec2 armA = contact.point - glm::vec2(bodies.x[a], bodies.y[a]);
+        glm::vec2 armB = contact.point - glm::vec2(bodies.x[b], bodies.y[b]);
+
+        // effective mass along a direction: how much the relative velocity at the contact point
+        // changes per unit of impulse
+        auto effectiveMass = [&](glm::vec2 direction) {
+            float turnA = armA.x * direction.y - armA.y * direction.x;
+            float turnB = armB.x * direction.y - armB.y * direction.x;
+            float k = bodies.invMass[a] + bodies.invMass[b] +
+                bodies.invInertia[a] * turnA * turnA + bodies.invInertia[b] * turnB * turnB;
+            return k > 0.0f ? 1.0f / k : 0.0f;
+        };
+
+        glm::vec2 velocityA = glm::vec2(bodies.vx[a], bodies.vy[a]) + bodies.w[a] * glm::vec2(-armA.y, armA.x);
+        glm::vec2 velocityB = glm::vec2(bodies.vx[b], bodies.vy[b]) + bodies.w[b] * glm::vec2(-armB.y, armB.x);
+        float approach = glm::dot(velocityB - velocityA, n);
+        float bias = CORRECTION_RATE / dt * std::max(contact.depth - CONTACT_SLOP, 0.0f);
+        if (approach < -BOUNCE_THRESHOLD)
+            bias = std::max(bias, -std::max(bodies.restitution[a], bodies.restitution[b]) * approach);
+
+        c.bodyA[lane] = a;
+        c.bodyB[lane] = b;
+        c.normalX[lane] = n.x;
+        c.normalY[lane] = n.y;
+        c.armAX[lane] = armA.x;
+        c.armAY[lane] = armA.y;
+        c.armBX[lane] = armB.x;
+        c.armBY[lane] = armB.y;
+        c.normalMass[lane] = effectiveMass(n);
+        c.tangentMass[lane] = effectiveMass(t);
+        c.bias[lane] = bias;
+        c.friction[lane] = world.friction;
+    }
+}
+
+static glm::vec4 loadLanes(const std::vector<float>& column, int first) {
+    return glm::make_vec4(&column[first]);
+}
+
+static void storeLanes(std::vector<float>& column, int first, const glm::vec4& lanes) {
+    std::memcpy(&column[first], glm::value_ptr(lanes), sizeof(lanes));
+}
+
+// batch solve: one sequential impulse iteration for the PHYSICS_LANES contacts of a batch, friction
+// first, then the normal impulse; glm::vec4 arithmetic maps onto SSE with GLM_FORCE_INTRINSICS
+// the bodies are gathered into lanes and scattered back, static bodies are never written
+static void solveBatch(PhysicsBodies& bodies, ContactConstraints& c, int batch) {
+    int first = batch * PHYSICS_LANES;
+    glm::vec4 vxA, vyA, wA, massA, inertiaA, vxB, vyB, wB, massB, inertiaB;
+    for (int lane = 0; lane < PHYSICS_LANES; lane++) {
+        int a = c.bodyA[first + lane], b = c.bodyB[first + lane];
+        vxA[lane] = bodies.vx[a];
+        vyA[lane] = bodies.vy[a];
+        wA[lane] = bodies.w[a];
+        massA[lane] = bodies.invMass[a];
+        inertiaA[lane] = bodies.invInertia[a];
+        vxB[lane] = bodies.vx[b];
+        vyB[lane] = bodies.vy[b];
+        wB[lane] = bodies.w[b];
+        massB[lane] = bodies.invMass[b];
+        inertiaB[lane] = bodies.invInertia[b];
+    }
+
+    glm::vec4 nx = loadLanes(c.normalX, first), ny = loadLanes(c.normalY, first);
+    glm::vec4 rxA = loadLanes(c.armAX, first), ryA = loadLanes(c.armAY, first);
+    glm::vec4 rxB = loadLanes(c.armBX, first), ryB = loadLanes(c.armBY, first);
+
+    // impulse application: p along (px, py) at the contact point, -p on a and +p on b
+    auto apply = [&](const glm::vec4& px, const glm::vec4& py) {
+        vxA -= massA * px;
+        vyA -= massA * py;
+        wA -= inertiaA * (rxA * py - ryA * px);
+        vxB += massB * px;
+        vyB += massB * py;
+        wB += inertiaB * (rxB * py - ryB * px);
+    };
+
+    // friction: drive the tangential velocity to zero, limited by the normal impulse so far
+    glm::vec4 tx = -ny, ty = nx;
+    glm::vec4 dvx = vxB - wB * ryB - vxA + wA * ryA;
+    glm::vec4 dvy = vyB + wB * rxB - vyA - wA * rxA;
+    glm::vec4 limit = loadLanes(c.friction, first) * loadLanes(c.normalImpulse, first);
+    glm::vec4 oldTangent = loadLanes(c.tangentImpulse, first);
+    glm::vec4 tangent = glm::clamp(oldTangent - loadLanes(c.tangentMass, first) * (dvx * tx + dvy * ty),
+        -limit, limit);
+    storeLanes(c.tangentImpulse, first, tangent);
+    apply((tangent - oldTangent) * tx, (tangent - oldTangent) * ty);
+
+    // normal: reach the target velocity, the accumulated impulse may only push
+    dvx = vxB - wB * ryB - vxA + wA * ryA;
+    dvy = vyB + wB * rxB - vyA - wA * rxA;
+    glm::vec4 oldNormal = loadLanes(c.normalImpulse, first);
+    glm::vec4 normal = glm::max(oldNormal + loadLanes(c.normalMass, first) *
+        (loadLanes(c.bias, first) - (dvx * nx + dvy * ny)), glm::vec4(0.0f));
+    storeLanes(c.normalImpulse, first, normal);
+    apply((normal - oldNormal) * nx, (normal - oldNormal) * ny);
+
+    for (int lane = 0; lane < PHYSICS_LANES; lane++) {
+        int a = c.bodyA[first + lane], b = c.bodyB[first + lane];
+        if (isDynamic(bodies, a)) {
+            bodies.vx[a] = vxA[lane];
+            bodies.vy[a] = vyA[lane];
+            bodies.w[a] = wA[lane];
+        }
+        if (isDynamic(bodies, b)) {
+            bodies.vx[b] = vxB[lane];
+            bodies.vy[b] = vyB[lane];
+            bodies.w[b] = wB[lane];
+        }
+    }
+}
+
+// step barrier: the solver threads wait for each other after every color
+struct StepBarrier {
+    std::mutex mutex;
+    std::condition_variable released;
+    int threads;
+    int waiting;
+    unsigned int generation;
+};
+
+static void barrierWait(StepBarrier& barrier) {
+    std::unique_lock<std::mutex> lock(barrier.mutex);
+    unsigned int generation = barrier.generation;
+    if (++barrier.waiting == barrier.threads) {
+        barrier.waiting = 0;
+        barrier.generation++;
+        barrier.released.notify_all();
+        return;
+    }
+    barrier.released.wait(lock, [&]() { return barrier.generation != generation; });
+}
+
+// solver thread: its share of the batches of every color, iteration after iteration
+static void solveConstraints(PhysicsWorld& world, int thread, int threads, StepBarrier* barrier) {
+    ContactConstraints& c = world.constraints;
+    int colors = (int)c.colorStart.size() - 1;
+    for (int iteration = 0; iteration < world.iterations; iteration++) {
+        for (int color = 0; color < colors; color++) {
+            int first = c.colorStart[color], count = c.colorStart[color + 1] - first;
+            bool serial = c.serialColor && color == colors - 1;
+            int begin = serial ? (thread == 0 ? first : first + count) : first + count * thread / threads;
+            int end = serial ? first + count : first + count * (thread + 1) / threads;
+            for (int batch = begin; batch < end; batch++)
+                solveBatch(world.bodies, c, batch);
+            if (barrier)
+                barrierWait(*barrier);
+        }
+    }
+}
+
+// bounds: keep the bounding circle inside [low, high] on one axis, reflect a velocity pointing out
+static void bounce(float& position, float& velocity, float radius, float low, float high, float restitution) {
+    if (position - radius < low) {
+        position = low + radius;
+        if (velocity < 0.0f)
+            velocity *= -restitution;
+    } else if (position + radius > high) {
+        position = high - radius;
+        if (velocity > 0.0f)
+            velocity *= -restitution;
+    }
+}
+
+void physicsStep(PhysicsWorld& world, const std::vector<ContactPair>& contacts, float dt) {
+    PhysicsBodies& bodies = world.bodies;
+    int count = (int)bodies.x.size();
+
+    // forces: gravity and damping change the velocities before the contacts see them
+    float linearKeep = 1.0f / (1.0f + dt * world.linearDamping);
+    float angularKeep = 1.0f / (1.0f + dt * world.angularDamping);
+    for (int i = 0; i < count; i++) {
+        if (!isDynamic(bodies, i))
+            continue;
+        if (bodies.invMass[i] > 0.0f) {
+            bodies.vx[i] = (bodies.vx[i] + world.gravity.x * dt) * linearKeep;
+            bodies.vy[i] = (bodies.vy[i] + world.gravity.y * dt) * linearKeep;
+        }
+        bodies.w[i] *= angularKeep;
+    }
+
+    // contacts: sequential impulses, the colors on as many threads as there are batches to share
+    prepareConstraints(world, contacts, dt);
+    int batches = world.constraints.colorStart.back();
+    int threads = world.threads > 0 ? world.threads : (int)std::thread::hardware_concurrency();
+    threads = std::max(1, std::min(threads, batches / BATCHES_PER_THREAD));
+    if (threads == 1) {
+        solveConstraints(world, 0, 1, NULL);
+    } else {
+        StepBarrier barrier;
+        barrier.threads = threads;
+        barrier.waiting = 0;
+        barrier.generation = 0;
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++)
+            workers.emplace_back(solveConstraints, std::ref(world), t, threads, &barrier);
+        solveConstraints(world, 0, threads, &barrier);
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    // integration: move the dynamic bodies, bounce them off the bounds
+    for (int i = 0; i < count; i++) {
+        if (!isDynamic(bodies, i))
+            continue;
+        bodies.x[i] += bodies.vx[i] * dt;
+        bodies.y[i] += bodies.vy[i] * dt;
+        bodies.angle[i] += bodies.w[i] * dt;
+
+        bounce(bodies.x[i], bodies.vx[i], bodies.radius[i], world.boundsMin.x, world.boundsMax.x,
+            bodies.restitution[i]);
+        bounce(bodies.y[i], bodies.vy[i], bodies.radius[i], world.boundsMin.y, world.boundsMax.y,
+            bodies.restitution[i]);
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "collision.h"
+
+// lanes of a constraint batch: the solver works on this many contacts at once (one glm::vec4)
+const int PHYSICS_LANES = 4;
+
+// structure to store the mass and the moment of inertia of a shape at density 1, about the origin
+struct MassProperties {
+    float mass;
+    float inertia;
+};
+
+// structure to store the rigid bodies, one array per quantity (SoA), so the solver reads the
+// state of a body from a few separate arrays and a step only touches the quantities it needs
+// a body with zero inverse mass and inertia is static or kinematic: contacts don't push it and the
+// step doesn't move it, its owner does; body 0 is such a body, used by the padding lanes
+struct PhysicsBodies {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> angle;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> w; // angular velocity, radians per second
+    std::vector<float> invMass;
+    std::vector<float> invInertia;
+    std::vector<float> restitution;
+    std::vector<float> radius; // bounding circle around the origin, for the world bounds
+};
+
+// structure to store the contact constraints of a step, SoA in batches of PHYSICS_LANES
+// constraints are grouped by color: no two constraints of a color share a dynamic body, so the
+// lanes of a batch and the batches of a color can be solved at the same time
+// batches of color c are colorStart[c] up to colorStart[c + 1]; when serialColor is set, the last
+// color holds the constraints that found no free color, one per batch, solved on one thread
+struct ContactConstraints {
+    std::vector<int> bodyA;
+    std::vector<int> bodyB;
+    std::vector<float> normalX;
+    std::vector<float> normalY;
+    std::vector<float> armAX; // contact point relative to the origin of a
+    std::vector<float> armAY;
+    std::vector<float> armBX;
+    std::vector<float> armBY;
+    std::vector<float> normalMass;
+    std::vector<float> tangentMass;
+    std::vector<float> bias; // target normal velocity: position correction and restitution
+    std::vector<float> friction;
+    std::vector<float> normalImpulse;  // accumulated over the iterations
+    std::vector<float> tangentImpulse;
+    std::vector<int> colorStart;
+    bool serialColor;
+};
+
+// structure to store the bodies, the settings and the scratch state of the steps
+struct PhysicsWorld {
+    PhysicsBodies bodies;
+    ContactConstraints constraints;
+    glm::vec2 gravity;
+    glm::vec2 boundsMin; // bodies bounce off the bounds with their restitution
+    glm::vec2 boundsMax;
+    float linearDamping;  // fraction of the velocity lost per second
+    float angularDamping;
+    float friction;
+    int iterations;
+    int threads; // solver threads, 0 for one per core; small steps use fewer
+
+    std::vector<uint32_t> bodyColors; // colors taken by every body while coloring
+    std::vector<int> contactColors;
+};
+
+// world setup: no gravity, bounds of the window in normalized device coordinates, the static body 0
+PhysicsWorld physicsWorldInit();
+
+// mass properties of a simple polygon (either winding) moved by offset, at density 1
+MassProperties polygonMass(const std::vector<glm::vec2>& outline, glm::vec2 offset);
+
+// body creation: mass 0 makes a static body, returns the body index
+int addPhysicsBody(PhysicsWorld& world, glm::vec2 position, float angle, float mass, float inertia,
+    float restitution, float radius);
+
+// step: contact impulses for the contacts between bodies (a and b are body indices), then the
+// velocities and positions of the dynamic bodies are integrated over dt
+void physicsStep(PhysicsWorld& world, const std::vector<ContactPair>& contacts, float dt);
+
+#endif
@@ -0,0 +1,16 @@
+#include "picking.h"
+
+bool pointInPolygon(glm::vec2 point, const glm::vec2* outline, int count) {
+    bool inside = false;
+
+    // crossing count: every edge that straddles the horizontal line through the point and
+    // crosses it right of the point flips the result
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+        const glm::vec2& a = outline[i];
+        const glm::vec2& b = outline[j];
+        if ((a.y > point.y) != (b.y > point.y) &&
+                point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x)
+            inside = !inside;
+    }
+    return inside;
+}
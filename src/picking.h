@@ -0,0 +1,9 @@
+#ifndef PICKING_H
+#define PICKING_H
+
+#include <glm/glm.hpp>
+
+// point in polygon: even-odd crossing test against a closed outline, works for concave outlines
+bool pointInPolygon(glm::vec2 point, const glm::vec2* outline, int count);
+
+#endif
@@ -0,0 +1,31 @@
+#include "redraw.h"
+
+RedrawState redrawInit(bool onDemand) {
+    RedrawState state;
+    state.onDemand = onDemand;
+    state.dirty = true;
+    state.iterations = 0;
+    state.frames = 0;
+    return state;
+}
+
+bool redrawIdle(const RedrawState& state) {
+    return state.onDemand && !state.dirty;
+}
+
+bool redrawDecide(RedrawState& state, bool input, bool programsChanged) {
+    state.iterations++;
+    if (input || programsChanged)
+        state.dirty = true;
+    if (redrawIdle(state))
+        return false;
+
+    state.dirty = false;
+    state.frames++;
+    return true;
+}
+
+void redrawFrameDone(RedrawState& state, bool moving) {
+    if (moving)
+        state.dirty = true;
+}
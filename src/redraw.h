@@ -0,0 +1,30 @@
+#ifndef REDRAW_H
+#define REDRAW_H
+
+// structure to store the on-demand redraw state of the main loop
+// dirty is set by anything that changes the picture: input, a resize or window refresh, a running
+// animation or motion, a program that finished compiling; a frame is only rendered while it is set
+// every rendered frame is one simulation tick
+struct RedrawState {
+    bool onDemand; // false renders on every iteration (replays)
+    bool dirty;
+    unsigned long iterations;
+    unsigned long frames;
+};
+
+// redraw setup: the first iteration always renders
+RedrawState redrawInit(bool onDemand);
+
+// idle check: nothing to draw, the loop may sleep until the next event
+bool redrawIdle(const RedrawState& state);
+
+// redraw decision: count one loop iteration, input tells whether its input changes the scene (held
+// transform keys, the event handlers mark the scene dirty themselves) and programsChanged whether
+// the shader poll swapped a program in
+// returns true when the iteration renders a frame, which clears the dirty flag
+bool redrawDecide(RedrawState& state, bool input, bool programsChanged);
+
+// frame end: a scene still moving after the frame (animation, motion, physics) needs the next one
+void redrawFrameDone(RedrawState& state, bool moving);
+
+#endif
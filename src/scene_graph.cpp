@@ -0,0 +1,60 @@
+#include "scene_graph.h"
+
+#include <algorithm>
+
+SceneGraph sceneGraphInit() {
+    SceneGraph graph;
+    graph.firstDirty = 0;
+    graph.pass = 0;
+    return graph;
+}
+
+int addSceneNode(SceneGraph& graph, int parent, const glm::mat4& local) {
+    int index = (int)graph.nodes.size();
+    if (parent < -1 || parent >= index)
+        return -1;
+
+    SceneNode node;
+    node.parent = parent;
+    node.local = local;
+    node.world = local;
+    node.dirty = true;
+    node.updated = 0;
+    graph.nodes.push_back(node);
+    graph.firstDirty = std::min(graph.firstDirty, index);
+    return index;
+}
+
+void setLocalTransform(SceneGraph& graph, int node, const glm::mat4& local) {
+    SceneNode& entry = graph.nodes[node];
+    if (entry.local == local)
+        return;
+
+    entry.local = local;
+    entry.dirty = true;
+    graph.firstDirty = std::min(graph.firstDirty, node);
+}
+
+int updateWorldTransforms(SceneGraph& graph) {
+    int count = (int)graph.nodes.size();
+    if (graph.firstDirty >= count)
+        return 0;
+
+    // dirty propagation: a parent is always visited before its children, so by the time a child
+    // is reached its parent is final and tagged with this pass if it was rebuilt
+    graph.pass++;
+    int rebuilt = 0;
+    for (int i = graph.firstDirty; i < count; i++) {
+        SceneNode& node = graph.nodes[i];
+        bool parentChanged = node.parent >= 0 && graph.nodes[node.parent].updated == graph.pass;
+        if (!node.dirty && !parentChanged)
+            continue;
+
+        node.world = node.parent >= 0 ? graph.nodes[node.parent].world * node.local : node.local;
+        node.dirty = false;
+        node.updated = graph.pass;
+        rebuilt++;
+    }
+    graph.firstDirty = count;
+    return rebuilt;
+}
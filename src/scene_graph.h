@@ -0,0 +1,40 @@
+#ifndef SCENE_GRAPH_H
+#define SCENE_GRAPH_H
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// structure to store one node: its transform relative to the parent and the resulting world transform
+struct SceneNode {
+    int parent; // index of the parent node, -1 for a root
+    glm::mat4 local;
+    glm::mat4 world;
+    bool dirty;           // local transform changed since the last update
+    unsigned int updated; // update pass that last rebuilt the world transform
+};
+
+// structure to store the nodes in a flat array, sorted so every parent comes before its children
+// an update walks the array once, from the first dirty node on, and rebuilds only the nodes that
+// are dirty or have a parent that was rebuilt in the same pass
+struct SceneGraph {
+    std::vector<SceneNode> nodes;
+    int firstDirty; // lowest dirty index, nodes.size() when nothing is dirty
+    unsigned int pass;
+};
+
+// graph setup: an empty graph
+SceneGraph sceneGraphInit();
+
+// node creation: the parent has to exist already, which keeps the array topologically sorted
+// returns the index of the new node, -1 when the parent is invalid
+int addSceneNode(SceneGraph& graph, int parent, const glm::mat4& local);
+
+// local transform: marks the node (and so its subtree) dirty, an unchanged transform is ignored
+void setLocalTransform(SceneGraph& graph, int node, const glm::mat4& local);
+
+// world transform update: one linear pass over the dirty part of the array
+// returns how many world transforms were rebuilt, 0 when the graph was clean
+int updateWorldTransforms(SceneGraph& graph);
+
+#endif
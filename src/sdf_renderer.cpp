@@ -0,0 +1,143 @@
+#include "sdf_renderer.h"
+
+#include <glad/glad.h>
+
+// quad corners: two triangles covering [-1, 1], scaled to the shape radius in the vertex shader
+static const float QUAD_CORNERS[] = {
+    -1.0f, -1.0f,   1.0f, -1.0f,   1.0f,  1.0f,
+    -1.0f, -1.0f,   1.0f,  1.0f,  -1.0f,  1.0f
+};
+
+const char* sdfVertexShaderSource = "#version 330 core\n"
+    "layout (location = 0) in vec2 quadCorner;\n"
+    "layout (location = 1) in mat4 transform;\n"
+    "layout (location = 5) in vec4 shape;\n"
+    "layout (location = 6) in vec4 innerColor;\n"
+    "layout (location = 7) in vec4 outerColor;\n"
+    "out vec2 localPos;\n"
+    "flat out vec4 shapeParams;\n"
+    "flat out vec4 shapeInner;\n"
+    "flat out vec4 shapeOuter;\n"
+    "void main()\n"
+    "{\n"
+    "   // quad margin: a little room outside the radius for the smoothed edge\n"
+    "   localPos = quadCorner * shape.y * 1.1;\n"
+    "   gl_Position = transform * vec4(localPos, 0.0, 1.0);\n"
+    "   shapeParams = shape;\n"
+    "   shapeInner = innerColor;\n"
+    "   shapeOuter = outerColor;\n"
+    "}\0";
+
+const char* sdfFragmentShaderSource = "#version 330 core\n"
+    "uniform bool edgeSmoothing;\n"
+    "in vec2 localPos;\n"
+    "flat in vec4 shapeParams;\n"
+    "flat in vec4 shapeInner;\n"
+    "flat in vec4 shapeOuter;\n"
+    "out vec4 finalColor;\n"
+    "\n"
+    "// regular polygon distance: fold the point into one sector, then measure to that sector's edge\n"
+    "float polygonDistance(vec2 p, float radius, float sides)\n"
+    "{\n"
+    "   if (sides < 3.0)\n"
+    "      return length(p) - radius;\n"
+    "   float halfAngle = 3.14159265 / sides;\n"
+    "   float angle = mod(atan(p.y, p.x), 2.0 * halfAngle) - halfAngle;\n"
+    "   p = length(p) * vec2(cos(angle), abs(sin(angle)));\n"
+    "   p -= radius * vec2(cos(halfAngle), sin(halfAngle));\n"
+    "   p.y += clamp(-p.y, 0.0, radius * sin(halfAngle));\n"
+    "   return length(p) * sign(p.x);\n"
+    "}\n"
+    "\n"
+    "vec3 hue(float turns)\n"
+    "{\n"
+    "   return clamp(abs(mod(turns * 6.0 + vec3(0.0, 4.0, 2.0), 6.0) - 3.0) - 1.0, 0.0, 1.0);\n"
+    "}\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   float s = sin(shapeParams.w), c = cos(shapeParams.w);\n"
+    "   vec2 p = mat2(c, -s, s, c) * localPos;\n"
+    "   float d = polygonDistance(p, shapeParams.y - shapeParams.z, shapeParams.x) - shapeParams.z;\n"
+    "\n"
+    "   // edge coverage: the distance in pixels, faded out over one pixel around the edge\n"
+    "   float coverage = edgeSmoothing ? clamp(0.5 - d / max(fwidth(d), 1e-6), 0.0, 1.0) : step(d, 0.0);\n"
+    "   if (coverage <= 0.0)\n"
+    "      discard;\n"
+    "\n"
+    "   vec3 outer = shapeOuter.a > 0.5 ? hue(atan(p.y, p.x) / 6.2831853) : shapeOuter.rgb;\n"
+    "   vec3 color = mix(shapeInner.rgb, outer, clamp(length(p) / shapeParams.y, 0.0, 1.0));\n"
+    "   finalColor = vec4(color, coverage);\n"
+    "}\0";
+
+void sdfRendererInit(SdfRenderer& renderer) {
+    renderer.capacity = 0;
+    renderer.instances.clear();
+
+    glGenVertexArrays(1, &renderer.VAO);
+    glGenBuffers(1, &renderer.quadVBO);
+    glGenBuffers(1, &renderer.instanceVBO);
+    glBindVertexArray(renderer.VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, renderer.quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(QUAD_CORNERS), QUAD_CORNERS, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // instance attributes: the transform takes four locations (one per column), then the
+    // shape parameters and both colors, all advanced once per instance
+    glBindBuffer(GL_ARRAY_BUFFER, renderer.instanceVBO);
+    GLsizei stride = sizeof(SdfInstance);
+    for (int column = 0; column < 4; column++) {
+        glVertexAttribPointer(1 + column, 4, GL_FLOAT, GL_FALSE, stride,
+            (void*)(offsetof(SdfInstance, transform) + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(1 + column);
+        glVertexAttribDivisor(1 + column, 1);
+    }
+    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(SdfInstance, shape));
+    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(SdfInstance, innerColor));
+    glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(SdfInstance, outerColor));
+    for (int location = 5; location <= 7; location++) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    glBindVertexArray(0);
+}
+
+void sdfClear(SdfRenderer& renderer) {
+    renderer.instances.clear();
+}
+
+void sdfAddShape(SdfRenderer& renderer, const glm::mat4& transform, const SdfShape& shape) {
+    SdfInstance instance;
+    instance.transform = transform;
+    instance.shape = glm::vec4(shape.sides, shape.radius, shape.rounding, shape.rotation);
+    instance.innerColor = glm::vec4(shape.innerColor, 1.0f);
+    instance.outerColor = glm::vec4(shape.outerColor, shape.hueWheel ? 1.0f : 0.0f);
+    renderer.instances.push_back(instance);
+}
+
+void sdfDraw(SdfRenderer& renderer, unsigned int program) {
+    if (renderer.instances.empty())
+        return;
+
+    // instance upload: the buffer only grows, a frame with fewer shapes reuses it
+    glBindBuffer(GL_ARRAY_BUFFER, renderer.instanceVBO);
+    std::size_t bytes = renderer.instances.size() * sizeof(SdfInstance);
+    if (renderer.instances.size() > renderer.capacity) {
+        renderer.capacity = renderer.instances.size();
+        glBufferData(GL_ARRAY_BUFFER, bytes, renderer.instances.data(), GL_DYNAMIC_DRAW);
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, renderer.instances.data());
+    }
+
+    glUseProgram(program);
+    glBindVertexArray(renderer.VAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, (GLsizei)renderer.instances.size());
+}
+
+void sdfRendererDelete(SdfRenderer& renderer) {
+    glDeleteVertexArrays(1, &renderer.VAO);
+    glDeleteBuffers(1, &renderer.quadVBO);
+    glDeleteBuffers(1, &renderer.instanceVBO);
+}
@@ -0,0 +1,57 @@
+#ifndef SDF_RENDERER_H
+#define SDF_RENDERER_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// structure to describe one shape evaluated as a signed distance field
+// sides below 3 give a circle, rounding cuts the corners with that radius (in object space)
+// rotation turns the shape inside its quad, hueWheel replaces outerColor with a hue by angle
+struct SdfShape {
+    float sides;
+    float radius;
+    float rounding;
+    float rotation;
+    glm::vec3 innerColor;
+    glm::vec3 outerColor;
+    bool hueWheel;
+};
+
+// structure to store one instance as it is uploaded (per-instance vertex attributes)
+struct SdfInstance {
+    glm::mat4 transform;
+    glm::vec4 shape;      // sides, radius, rounding, rotation
+    glm::vec4 innerColor; // rgb, unused
+    glm::vec4 outerColor; // rgb, hue wheel flag
+};
+
+// structure to store the shared quad and the instance buffer, every shape is one quad
+struct SdfRenderer {
+    unsigned int VAO;
+    unsigned int quadVBO;
+    unsigned int instanceVBO;
+    std::size_t capacity; // instances the instance buffer currently holds
+    std::vector<SdfInstance> instances;
+};
+
+// built-in shader sources, used when shaders/sdf_shape.vert or .frag can't be read
+extern const char* sdfVertexShaderSource;
+extern const char* sdfFragmentShaderSource;
+
+// renderer setup: create the quad and the instance buffer, needs a current context
+void sdfRendererInit(SdfRenderer& renderer);
+
+// frame batch: clear at the start of a frame, add every shape drawn this frame
+void sdfClear(SdfRenderer& renderer);
+void sdfAddShape(SdfRenderer& renderer, const glm::mat4& transform, const SdfShape& shape);
+
+// batch drawing: upload the instances and draw all of them with one instanced call
+// the program must be one linked from the SDF shader sources
+void sdfDraw(SdfRenderer& renderer, unsigned int program);
+
+// renderer cleanse: delete the buffers and the vertex array
+void sdfRendererDelete(SdfRenderer& renderer);
+
+#endif
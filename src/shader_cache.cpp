@@ -0,0 +1,148 @@
+#include "shader_cache.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// GL_ARB_get_program_binary: not part of the generated 3.3 loader, resolved by hand
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC_PRIVATE)(GLuint program, GLsizei bufSize,
+    GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC_PRIVATE)(GLuint program, GLenum binaryFormat,
+    const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC_PRIVATE)(GLuint program, GLenum pname,
+    GLint value);
+
+const char* const CACHE_DIRECTORY = "shader_cache";
+const uint32_t CACHE_MAGIC = 0x50475342; // "BSGP"
+
+static PFNGLGETPROGRAMBINARYPROC_PRIVATE getProgramBinary = NULL;
+static PFNGLPROGRAMBINARYPROC_PRIVATE programBinary = NULL;
+static PFNGLPROGRAMPARAMETERIPROC_PRIVATE programParameteri = NULL;
+
+// extension check: resolve the entry points once, false when the driver can't do program binaries
+static bool binarySupported() {
+    static int supported = -1;
+    if (supported < 0) {
+        supported = gladHasExtension("GL_ARB_get_program_binary");
+        if (supported) {
+            getProgramBinary = (PFNGLGETPROGRAMBINARYPROC_PRIVATE)glfwGetProcAddress("glGetProgramBinary");
+            programBinary = (PFNGLPROGRAMBINARYPROC_PRIVATE)glfwGetProcAddress("glProgramBinary");
+            programParameteri = (PFNGLPROGRAMPARAMETERIPROC_PRIVATE)glfwGetProcAddress("glProgramParameteri");
+            supported = getProgramBinary && programBinary && programParameteri;
+        }
+    }
+    return supported;
+}
+
+// FNV-1a: small and stable across builds, enough to tell shader/driver combinations apart
+static uint64_t hashString(uint64_t hash, const char* text) {
+    if (!text)
+        return hash;
+    for (; *text; text++) {
+        hash ^= (unsigned char)*text;
+        hash *= 0x100000001b3ULL;
+    }
+    // separator: "ab" + "c" must not hash like "a" + "bc"
+    hash ^= 0xff;
+    return hash * 0x100000001b3ULL;
+}
+
+static std::string cachePath(uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return std::string(CACHE_DIRECTORY) + "/" + name;
+}
+
+uint64_t programCacheKey(const char* vertexSource, const char* fragmentSource) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash = hashString(hash, vertexSource);
+    hash = hashString(hash, fragmentSource);
+    hash = hashString(hash, (const char*)glGetString(GL_VENDOR));
+    hash = hashString(hash, (const char*)glGetString(GL_RENDERER));
+    hash = hashString(hash, (const char*)glGetString(GL_VERSION));
+    return hash;
+}
+
+unsigned int loadProgramBinary(uint64_t key) {
+    if (!binarySupported())
+        return 0;
+
+    std::ifstream file(cachePath(key), std::ios::binary);
+    if (!file)
+        return 0;
+
+    // cache file layout: magic, key, binary format, length, binary
+    uint32_t magic = 0, format = 0, length = 0;
+    uint64_t storedKey = 0;
+    file.read((char*)&magic, sizeof(magic));
+    file.read((char*)&storedKey, sizeof(storedKey));
+    file.read((char*)&format, sizeof(format));
+    file.read((char*)&length, sizeof(length));
+    if (!file || magic != CACHE_MAGIC || storedKey != key || length == 0)
+        return 0;
+
+    std::vector<char> binary(length);
+    file.read(binary.data(), length);
+    if (!file)
+        return 0;
+
+    unsigned int program = glCreateProgram();
+    programBinary(program, format, binary.data(), length);
+
+    // driver mismatch: the driver may reject a binary even when the key matches
+    int status;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void programBinaryHint(unsigned int program) {
+    if (binarySupported())
+        programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void saveProgramBinary(unsigned int program, uint64_t key) {
+    if (!binarySupported())
+        return;
+
+    int status, length = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (!status || length <= 0)
+        return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    getProgramBinary(program, length, &length, &format, binary.data());
+
+    std::error_code error;
+    std::filesystem::create_directories(CACHE_DIRECTORY, error);
+    std::ofstream file(cachePath(key), std::ios::binary | std::ios::trunc);
+    if (error || !file) {
+        std::cout << "ERROR: could not write the shader cache" << std::endl;
+        return;
+    }
+
+    uint32_t magic = CACHE_MAGIC, format32 = format, length32 = length;
+    file.write((const char*)&magic, sizeof(magic));
+    file.write((const char*)&key, sizeof(key));
+    file.write((const char*)&format32, sizeof(format32));
+    file.write((const char*)&length32, sizeof(length32));
+    file.write(binary.data(), length);
+}
@@ -0,0 +1,18 @@
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+#include <cstdint>
+
+// cache key: hash of both shader sources and the driver vendor, renderer and version
+uint64_t programCacheKey(const char* vertexSource, const char* fragmentSource);
+
+// cached program: link a program from a stored binary, returns 0 on a miss or a driver mismatch
+unsigned int loadProgramBinary(uint64_t key);
+
+// retrievable hint: ask the driver to keep the binary around (call before glLinkProgram)
+void programBinaryHint(unsigned int program);
+
+// program store: write the binary of a successfully linked program to the cache directory
+void saveProgramBinary(unsigned int program, uint64_t key);
+
+#endif
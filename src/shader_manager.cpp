@@ -0,0 +1,205 @@
+#include "shader_manager.h"
+#include "shader_cache.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstring>
+#include <iostream>
+
+// GL_KHR_parallel_shader_compile: not part of the generated 3.3 loader, resolved by hand
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC_PRIVATE)(GLuint count);
+
+// error generation for wrong shader compilation
+static bool shaderErrLogger(unsigned int shaderType, const char* name) {
+    int status = 1;
+    char errLog[1024];
+
+    if (std::strcmp(name, "shader") == 0) {
+        glGetShaderiv(shaderType, GL_COMPILE_STATUS, &status);
+
+        if (!status) {
+            glGetShaderInfoLog(shaderType, 1024, NULL, errLog);
+            std::cout << "ERROR: shader compilation unsuccessful\n" <<
+                errLog << std::endl;
+        }
+    }
+    else if (std::strcmp(name, "program") == 0) {
+        glGetProgramiv(shaderType, GL_LINK_STATUS, &status);
+
+        if (!status) {
+            glGetProgramInfoLog(shaderType, 1024, NULL, errLog);
+            std::cout << "ERROR: shader link unsuccessful\n" <<
+                errLog << std::endl;
+        }
+    }
+    return status;
+}
+
+// program swap: the new program replaces the live one
+static void swapProgram(ShaderProgram& entry, unsigned int program) {
+    if (entry.program)
+        glDeleteProgram(entry.program);
+    entry.program = program;
+    entry.ready = true;
+    entry.failed = false;
+}
+
+// program completion: log errors, drop the shader objects and store the binary
+static void finishProgram(ShaderProgram& entry) {
+    bool compiled = shaderErrLogger(entry.vertexShader, "shader");
+    compiled = shaderErrLogger(entry.fragmentShader, "shader") && compiled;
+    bool linked = shaderErrLogger(entry.pendingProgram, "program");
+
+    // deprecated shader clease: delete the linked shaders for realocation
+    glDetachShader(entry.pendingProgram, entry.vertexShader);
+    glDetachShader(entry.pendingProgram, entry.fragmentShader);
+    glDeleteShader(entry.vertexShader);
+    glDeleteShader(entry.fragmentShader);
+    entry.vertexShader = 0;
+    entry.fragmentShader = 0;
+
+    if (compiled && linked) {
+        saveProgramBinary(entry.pendingProgram, entry.cacheKey);
+        swapProgram(entry, entry.pendingProgram);
+    } else {
+        glDeleteProgram(entry.pendingProgram);
+        entry.failed = true;
+    }
+    entry.pendingProgram = 0;
+}
+
+// compile start: compile and link without querying any status in between, so the driver can
+// run it all in the background; the status queries happen in finishProgram once it is done
+static void startProgram(ShaderProgram& entry) {
+    entry.cacheKey = programCacheKey(entry.vertexSource.c_str(), entry.fragmentSource.c_str());
+
+    // program cache: reuse the binary linked by an earlier launch on the same driver
+    unsigned int cached = loadProgramBinary(entry.cacheKey);
+    if (cached) {
+        swapProgram(entry, cached);
+        return;
+    }
+
+    const char* vertexSource = entry.vertexSource.c_str();
+    entry.vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(entry.vertexShader, 1, &vertexSource, NULL);
+    glCompileShader(entry.vertexShader);
+
+    const char* fragmentSource = entry.fragmentSource.c_str();
+    entry.fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(entry.fragmentShader, 1, &fragmentSource, NULL);
+    glCompileShader(entry.fragmentShader);
+
+    entry.pendingProgram = glCreateProgram();
+    glAttachShader(entry.pendingProgram, entry.vertexShader);
+    glAttachShader(entry.pendingProgram, entry.fragmentShader);
+    programBinaryHint(entry.pendingProgram);
+    glLinkProgram(entry.pendingProgram);
+}
+
+// compile abort: drop a compilation that is superseded by newer sources
+static void abortProgram(ShaderProgram& entry) {
+    if (!entry.pendingProgram)
+        return;
+    glDeleteShader(entry.vertexShader);
+    glDeleteShader(entry.fragmentShader);
+    glDeleteProgram(entry.pendingProgram);
+    entry.vertexShader = 0;
+    entry.fragmentShader = 0;
+    entry.pendingProgram = 0;
+}
+
+ShaderManager shaderManagerInit() {
+    ShaderManager manager;
+    manager.parallel = false;
+
+    PFNGLMAXSHADERCOMPILERTHREADSKHRPROC_PRIVATE maxCompilerThreads = NULL;
+    if (gladHasExtension("GL_KHR_parallel_shader_compile"))
+        maxCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC_PRIVATE)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+    else if (gladHasExtension("GL_ARB_parallel_shader_compile"))
+        maxCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC_PRIVATE)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+
+    // compiler threads: 0xFFFFFFFF lets the driver pick as many as it sees fit
+    if (maxCompilerThreads) {
+        maxCompilerThreads(0xFFFFFFFF);
+        manager.parallel = true;
+    }
+    return manager;
+}
+
+int submitProgram(ShaderManager& manager, const char* vertexSource, const char* fragmentSource) {
+    ShaderProgram entry = {};
+    entry.vertexSource = vertexSource;
+    entry.fragmentSource = fragmentSource;
+    startProgram(entry);
+
+    manager.programs.push_back(entry);
+    return (int)manager.programs.size() - 1;
+}
+
+void reloadProgram(ShaderManager& manager, int handle, const std::string& vertexSource,
+        const std::string& fragmentSource) {
+    ShaderProgram& entry = manager.programs[handle];
+    if (entry.vertexSource == vertexSource && entry.fragmentSource == fragmentSource && !entry.failed)
+        return;
+
+    abortProgram(entry);
+    entry.vertexSource = vertexSource;
+    entry.fragmentSource = fragmentSource;
+    startProgram(entry);
+}
+
+bool pollPrograms(ShaderManager& manager) {
+    bool becameReady = false;
+
+    for (ShaderProgram& entry : manager.programs) {
+        if (!entry.pendingProgram)
+            continue;
+
+        // without the extension the status query would block, so just finish the program
+        if (manager.parallel) {
+            int complete = 0;
+            glGetProgramiv(entry.pendingProgram, GL_COMPLETION_STATUS_KHR, &complete);
+            if (!complete)
+                continue;
+        }
+
+        finishProgram(entry);
+        becameReady = becameReady || !entry.failed;
+    }
+    return becameReady;
+}
+
+void waitProgram(ShaderManager& manager, int handle) {
+    ShaderProgram& entry = manager.programs[handle];
+    if (entry.pendingProgram)
+        finishProgram(entry);
+}
+
+bool programsPending(const ShaderManager& manager) {
+    for (const ShaderProgram& entry : manager.programs) {
+        if (entry.pendingProgram)
+            return true;
+    }
+    return false;
+}
+
+unsigned int programFor(const ShaderManager& manager, int handle, int fallback) {
+    if (manager.programs[handle].ready)
+        return manager.programs[handle].program;
+    return manager.programs[fallback].program;
+}
+
+void deleteShaderPrograms(ShaderManager& manager) {
+    for (ShaderProgram& entry : manager.programs) {
+        abortProgram(entry);
+        if (entry.program)
+            glDeleteProgram(entry.program);
+    }
+    manager.programs.clear();
+}
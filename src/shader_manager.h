@@ -0,0 +1,58 @@
+#ifndef SHADER_MANAGER_H
+#define SHADER_MANAGER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// structure to store one program and the state of its compilation
+struct ShaderProgram {
+    std::string vertexSource;
+    std::string fragmentSource;
+    uint64_t cacheKey;
+
+    unsigned int vertexShader;
+    unsigned int fragmentShader;
+    unsigned int pendingProgram; // being compiled, replaces program once it linked
+
+    unsigned int program; // live program, kept until a newer one links successfully
+    bool ready;  // program linked successfully, safe to draw with
+    bool failed; // last compile or link failed, already logged
+};
+
+// structure to store every submitted program
+// with GL_KHR_parallel_shader_compile the driver compiles them on its own threads
+struct ShaderManager {
+    std::vector<ShaderProgram> programs;
+    bool parallel;
+};
+
+// manager setup: enable parallel compilation when the driver supports it, needs a current context
+ShaderManager shaderManagerInit();
+
+// program submission: start compiling and linking, returns a handle for the other calls
+// a program found in the binary cache is ready immediately
+int submitProgram(ShaderManager& manager, const char* vertexSource, const char* fragmentSource);
+
+// program reload: compile new sources next to the live program and swap once they linked
+// a failing reload keeps the old program, so a typo never takes the scene down
+void reloadProgram(ShaderManager& manager, int handle, const std::string& vertexSource,
+    const std::string& fragmentSource);
+
+// program polling: finish every program whose compilation completed, never blocks
+// returns true when at least one program became ready this call
+bool pollPrograms(ShaderManager& manager);
+
+// blocking wait: finish one program now (used for the fallback program)
+void waitProgram(ShaderManager& manager, int handle);
+
+// pending check: are there programs still being compiled?
+bool programsPending(const ShaderManager& manager);
+
+// program selection: the requested program once ready, the fallback program until then
+unsigned int programFor(const ShaderManager& manager, int handle, int fallback);
+
+// manager cleanse: delete every program and any shader that is still attached
+void deleteShaderPrograms(ShaderManager& manager);
+
+#endif
@@ -0,0 +1,112 @@
+#include "shader_watcher.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+bool loadShaderFile(const std::string& path, std::string& source) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    source = contents.str();
+    return true;
+}
+
+std::string findShaderDirectory(const std::string& executable) {
+    std::filesystem::path executableDirectory = std::filesystem::path(executable).parent_path();
+    const std::filesystem::path candidates[] = {
+        executableDirectory / ".." / "shaders",
+        executableDirectory / ".." / ".." / "shaders",
+        "shaders",
+        std::filesystem::path("..") / "shaders"
+    };
+    for (const std::filesystem::path& candidate : candidates) {
+        std::error_code error;
+        if (std::filesystem::is_directory(candidate, error))
+            return candidate.lexically_normal().string();
+    }
+    return "";
+}
+
+static std::filesystem::file_time_type lastWriteTime(const std::string& path) {
+    std::error_code error;
+    std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+    return error ? std::filesystem::file_time_type::min() : time;
+}
+
+ShaderWatcher watcherInit(const std::string& directory) {
+    ShaderWatcher watcher;
+    watcher.directory = directory;
+    watcher.inotifyFd = -1;
+
+#ifdef __linux__
+    // editors either write in place or rename a temporary file over the original
+    watcher.inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher.inotifyFd >= 0 &&
+            inotify_add_watch(watcher.inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(watcher.inotifyFd);
+        watcher.inotifyFd = -1;
+    }
+#endif
+    return watcher;
+}
+
+void watchFile(ShaderWatcher& watcher, const std::string& name) {
+    watcher.files.push_back({name, lastWriteTime(watcher.directory + "/" + name)});
+}
+
+static bool isWatched(const ShaderWatcher& watcher, const std::string& name) {
+    for (const WatchedFile& file : watcher.files) {
+        if (file.name == name)
+            return true;
+    }
+    return false;
+}
+
+bool pollShaderChanges(ShaderWatcher& watcher, std::vector<std::string>& changed) {
+    changed.clear();
+
+#ifdef __linux__
+    if (watcher.inotifyFd >= 0) {
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(watcher.inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* at = buffer; at < buffer + length; ) {
+                inotify_event* event = (inotify_event*)at;
+                if (event->len > 0 && isWatched(watcher, event->name) &&
+                        std::find(changed.begin(), changed.end(), event->name) == changed.end())
+                    changed.push_back(event->name);
+                at += sizeof(inotify_event) + event->len;
+            }
+        }
+        return !changed.empty();
+    }
+#endif
+
+    // modification times: one stat per watched file
+    for (WatchedFile& file : watcher.files) {
+        std::filesystem::file_time_type time = lastWriteTime(watcher.directory + "/" + file.name);
+        if (time != file.lastWrite) {
+            file.lastWrite = time;
+            changed.push_back(file.name);
+        }
+    }
+    return !changed.empty();
+}
+
+void watcherClose(ShaderWatcher& watcher) {
+#ifdef __linux__
+    if (watcher.inotifyFd >= 0)
+        close(watcher.inotifyFd);
+#endif
+    watcher.inotifyFd = -1;
+    watcher.files.clear();
+}
@@ -0,0 +1,42 @@
+#ifndef SHADER_WATCHER_H
+#define SHADER_WATCHER_H
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// structure to store one watched shader file
+struct WatchedFile {
+    std::string name;
+    std::filesystem::file_time_type lastWrite;
+};
+
+// structure to store the shader directory watch
+// Linux uses inotify, other platforms compare file modification times on every poll
+struct ShaderWatcher {
+    std::string directory;
+    std::vector<WatchedFile> files;
+    int inotifyFd; // -1: inotify unavailable, fall back to modification times
+};
+
+// directory lookup: the shader directory for an executable path (argv[0]), found next to the
+// executable (bin/main), two levels up (build/<config>/main) or below the working directory;
+// returns an empty string when there is none
+std::string findShaderDirectory(const std::string& executable);
+
+// file loading: read a whole shader file, leaves source untouched when the file can't be read
+bool loadShaderFile(const std::string& path, std::string& source);
+
+// watcher setup: start watching a directory for shader changes
+ShaderWatcher watcherInit(const std::string& directory);
+
+// file registration: report changes of this file (name relative to the watched directory)
+void watchFile(ShaderWatcher& watcher, const std::string& name);
+
+// change polling: collect the names of watched files written since the last poll, never blocks
+bool pollShaderChanges(ShaderWatcher& watcher, std::vector<std::string>& changed);
+
+// watcher cleanse: stop watching
+void watcherClose(ShaderWatcher& watcher);
+
+#endif
@@ -0,0 +1,111 @@
+#include "trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// buffer size: per thread, the oldest spans are overwritten once it is full
+const std::size_t TRACE_CAPACITY = 1 << 16;
+const int TRACE_MAX_DEPTH = 16;
+
+bool traceEnabled = false;
+
+// structure to store the spans of one thread
+// only the owning thread writes; count is published with release so the exporter sees whole events
+struct TraceBuffer {
+    unsigned int threadId;
+    std::atomic<std::size_t> count{0};
+    TraceEvent events[TRACE_CAPACITY];
+
+    // open spans of this thread
+    const char* openNames[TRACE_MAX_DEPTH];
+    uint64_t openBegins[TRACE_MAX_DEPTH];
+    int depth = 0;
+};
+
+// buffer registry: touched once per thread on its first span and by the exporter
+static std::mutex registryMutex;
+static std::vector<std::unique_ptr<TraceBuffer>> registry;
+static const std::chrono::steady_clock::time_point traceStart = std::chrono::steady_clock::now();
+
+static uint64_t traceNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - traceStart).count();
+}
+
+static TraceBuffer* threadBuffer() {
+    thread_local TraceBuffer* buffer = NULL;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.emplace_back(new TraceBuffer());
+        buffer = registry.back().get();
+        buffer->threadId = (unsigned int)registry.size();
+    }
+    return buffer;
+}
+
+void traceBegin(const char* name) {
+    if (!traceEnabled)
+        return;
+
+    TraceBuffer* buffer = threadBuffer();
+    if (buffer->depth < TRACE_MAX_DEPTH) {
+        buffer->openNames[buffer->depth] = name;
+        buffer->openBegins[buffer->depth] = traceNow();
+    }
+    buffer->depth++;
+}
+
+void traceEnd() {
+    if (!traceEnabled)
+        return;
+
+    TraceBuffer* buffer = threadBuffer();
+    if (buffer->depth == 0)
+        return;
+    buffer->depth--;
+    if (buffer->depth >= TRACE_MAX_DEPTH)
+        return;
+
+    std::size_t count = buffer->count.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer->events[count % TRACE_CAPACITY];
+    event.name = buffer->openNames[buffer->depth];
+    event.begin = buffer->openBegins[buffer->depth];
+    event.end = traceNow();
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+bool traceExport(const char* path) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        std::cout << "ERROR: could not write trace file " << path << std::endl;
+        return false;
+    }
+
+    // trace-event format: complete events ("X") with microsecond timestamps
+    std::size_t written = 0;
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const std::unique_ptr<TraceBuffer>& buffer : registry) {
+        std::size_t count = buffer->count.load(std::memory_order_acquire);
+        std::size_t first = count > TRACE_CAPACITY ? count - TRACE_CAPACITY : 0;
+
+        for (std::size_t i = first; i < count; i++) {
+            const TraceEvent& event = buffer->events[i % TRACE_CAPACITY];
+            file << (written++ ? ",\n" : "\n") << "{\"name\":\"" << event.name <<
+                "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId <<
+                ",\"ts\":" << event.begin / 1000.0 << ",\"dur\":" <<
+                (event.end - event.begin) / 1000.0 << "}";
+        }
+    }
+    file << "\n]}\n";
+
+    std::cout << "INFO: trace with " << written << " spans written to " << path << std::endl;
+    return true;
+}
@@ -0,0 +1,25 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+
+// structure to store one finished trace span
+struct TraceEvent {
+    const char* name; // must be a string literal, only the pointer is stored
+    uint64_t begin;   // nanoseconds since the trace clock started
+    uint64_t end;
+};
+
+// trace recording: off by default, markers cost one branch while disabled
+extern bool traceEnabled;
+
+// span markers: nest up to TRACE_MAX_DEPTH deep per thread, every begin needs its end
+// each thread records into its own buffer, so markers never take a lock
+void traceBegin(const char* name);
+void traceEnd();
+
+// trace export: write every recorded span as Chrome trace-event JSON
+// (chrome://tracing, ui.perfetto.dev), returns false when the file can't be written
+bool traceExport(const char* path);
+
+#endif
@@ -0,0 +1,49 @@
+#include "viewport.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+Viewport viewportInit() {
+    Viewport viewport;
+    viewport.windowWidth = 0;
+    viewport.windowHeight = 0;
+    viewport.framebufferWidth = 0;
+    viewport.framebufferHeight = 0;
+    viewport.extent = glm::vec2(1.0f);
+    viewport.projection = glm::mat4(1.0f);
+    return viewport;
+}
+
+bool resizeViewport(Viewport& viewport, int windowWidth, int windowHeight, int framebufferWidth,
+        int framebufferHeight) {
+    if (windowWidth <= 0 || windowHeight <= 0 || framebufferWidth <= 0 || framebufferHeight <= 0)
+        return false;
+    if (windowWidth == viewport.windowWidth && windowHeight == viewport.windowHeight &&
+            framebufferWidth == viewport.framebufferWidth && framebufferHeight == viewport.framebufferHeight)
+        return false;
+
+    viewport.windowWidth = windowWidth;
+    viewport.windowHeight = windowHeight;
+    viewport.framebufferWidth = framebufferWidth;
+    viewport.framebufferHeight = framebufferHeight;
+
+    // aspect: from the framebuffer, the pixels actually drawn (the same as the window's, unless
+    // the platform scales the two axes differently)
+    float aspect = (float)framebufferWidth / (float)framebufferHeight;
+    viewport.extent = aspect >= 1.0f ? glm::vec2(aspect, 1.0f) : glm::vec2(1.0f, 1.0f / aspect);
+    viewport.projection = glm::ortho(-viewport.extent.x, viewport.extent.x, -viewport.extent.y, viewport.extent.y);
+    return true;
+}
+
+glm::vec2 cursorToWorld(const Viewport& viewport, double x, double y) {
+    if (viewport.windowWidth <= 0 || viewport.windowHeight <= 0)
+        return glm::vec2(0.0f);
+    glm::vec2 ndc((float)(x / viewport.windowWidth * 2.0 - 1.0), (float)(1.0 - y / viewport.windowHeight * 2.0));
+    return ndc * viewport.extent;
+}
+
+glm::vec2 cursorMotionToWorld(const Viewport& viewport, double deltaX, double deltaY) {
+    if (viewport.windowWidth <= 0 || viewport.windowHeight <= 0)
+        return glm::vec2(0.0f);
+    glm::vec2 ndc((float)(deltaX / viewport.windowWidth * 2.0), (float)(-deltaY / viewport.windowHeight * 2.0));
+    return ndc * viewport.extent;
+}
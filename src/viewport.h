@@ -0,0 +1,33 @@
+#ifndef VIEWPORT_H
+#define VIEWPORT_H
+
+#include <glm/glm.hpp>
+
+// structure to store the window size and everything derived from it
+// cursor positions arrive in window coordinates, GL renders in framebuffer pixels; on HiDPI
+// screens the framebuffer is larger than the window (by the content scale)
+// the projection keeps the world undistorted: the shorter side of the window spans -1 to 1,
+// the longer one shows more of the world, extent is half the visible world size
+struct Viewport {
+    int windowWidth;
+    int windowHeight;
+    int framebufferWidth;
+    int framebufferHeight;
+    glm::vec2 extent;
+    glm::mat4 projection;
+};
+
+// viewport setup: no size yet, the identity projection
+Viewport viewportInit();
+
+// resize: store the new sizes and rebuild the projection, returns false when nothing changed
+// a zero size (minimized window) is ignored, the last size stays in use
+bool resizeViewport(Viewport& viewport, int windowWidth, int windowHeight, int framebufferWidth,
+    int framebufferHeight);
+
+// cursor mapping: a cursor position (window coordinates) as a world position, and a cursor
+// motion as a world motion
+glm::vec2 cursorToWorld(const Viewport& viewport, double x, double y);
+glm::vec2 cursorMotionToWorld(const Viewport& viewport, double deltaX, double deltaY);
+
+#endif
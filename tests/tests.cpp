@@ -0,0 +1,302 @@
+// checks for the loop logic and the modules that run without a window
+// usage: tests, the exit code is the number of failed checks
+#include "../src/animation.h"
+#include "../src/image_compare.h"
+#include "../src/input_queue.h"
+#include "../src/input_record.h"
+#include "../src/redraw.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+// failed checks of the whole run
+int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+// on-demand redraw: idle iterations render nothing, input renders exactly one frame and a moving
+// scene renders until it stops
+static void testRedraw() {
+    RedrawState state = redrawInit(true);
+    check(redrawDecide(state, false, false), "redraw: the first iteration renders");
+
+    const int IDLE_ITERATIONS = 100;
+    for (int i = 0; i < IDLE_ITERATIONS; i++)
+        redrawDecide(state, false, false);
+    check(state.frames == 1, "redraw: idle iterations render no frames");
+    check(redrawIdle(state), "redraw: an idle loop may sleep");
+
+    redrawDecide(state, true, false);
+    for (int i = 0; i < IDLE_ITERATIONS; i++)
+        redrawDecide(state, false, false);
+    check(state.frames == 2, "redraw: one input renders exactly one frame");
+
+    redrawDecide(state, false, true);
+    check(state.frames == 3, "redraw: a finished shader program renders a frame");
+
+    // moving: three frames still moving, then one that stops
+    state.dirty = true;
+    for (int moving = 3; moving >= 0; moving--) {
+        if (redrawDecide(state, false, false))
+            redrawFrameDone(state, moving > 0);
+    }
+    for (int i = 0; i < IDLE_ITERATIONS; i++)
+        redrawDecide(state, false, false);
+    check(state.frames == 7, "redraw: a moving scene renders until it stops");
+
+    RedrawState always = redrawInit(false);
+    for (int i = 0; i < IDLE_ITERATIONS; i++)
+        redrawDecide(always, false, false);
+    check(always.frames == IDLE_ITERATIONS, "redraw: without on-demand every iteration renders");
+}
+
+// solid image: every pixel the same grey
+static Image solidImage(int width, int height, unsigned char value) {
+    Image image;
+    image.width = width;
+    image.height = height;
+    image.pixels.assign((std::size_t)width * height * 3, value);
+    return image;
+}
+
+// golden comparison: a wrong size fails without a diff image, a wrong picture fails with its own
+static void testGoldenComparison() {
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "renderer_tests_golden";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "result");
+    std::filesystem::create_directories(root / "golden");
+    savePpm((root / "result" / "a_off.ppm").string(), solidImage(4, 4, 200));
+    savePpm((root / "golden" / "a_off.ppm").string(), solidImage(4, 4, 0));
+    savePpm((root / "result" / "b_size.ppm").string(), solidImage(4, 4, 0));
+    savePpm((root / "golden" / "b_size.ppm").string(), solidImage(4, 5, 0));
+    savePpm((root / "result" / "c_same.ppm").string(), solidImage(4, 4, 9));
+    savePpm((root / "golden" / "c_same.ppm").string(), solidImage(4, 4, 9));
+
+    int failed = compareWithGolden((root / "result").string(), (root / "golden").string(), 8.0, 0.0);
+    check(failed == 2, "golden: the wrong picture and the wrong size fail, the same picture matches");
+    check(std::filesystem::exists(root / "result" / "diff_a_off.ppm"), "golden: a wrong picture gets a diff image");
+    check(!std::filesystem::exists(root / "result" / "diff_b_size.ppm"), "golden: a wrong size gets no diff image");
+    check(!std::filesystem::exists(root / "result" / "diff_c_same.ppm"), "golden: a match gets no diff image");
+
+    Image diff = solidImage(1, 1, 0);
+    ImageDiff outcome = compareImages(solidImage(4, 4, 0), solidImage(4, 5, 0), 8.0, 0.0, &diff);
+    check(!outcome.match, "golden: images of different sizes don't match");
+    std::filesystem::remove_all(root);
+}
+
+// structure to store a small simulation driven like the objects of main: a cursor move only
+// stores the position, a press flings the object with a speed taken from it, held keys push it;
+// the fling slows down over many ticks without any input
+// a key toggles a looping animation ("F3"), which advances every tick until it is stopped
+struct ReplaySim {
+    float position;
+    float velocity;
+    float cursor;
+    bool animating;
+    float animationTime;
+};
+
+// input handlers: the events mark the scene dirty themselves, like the handlers of main
+static void replayApply(ReplaySim& sim, RedrawState& redraw, const InputFrame& frame) {
+    for (const InputEvent& event : frame.events) {
+        if (event.type == INPUT_CURSOR_MOVE) {
+            sim.cursor = (float)event.x;
+        } else if (event.type == INPUT_MOUSE_PRESS) {
+            sim.velocity = sim.cursor;
+            redraw.dirty = true;
+        } else if (event.type == INPUT_KEY) {
+            sim.animating = !sim.animating;
+            redraw.dirty = true;
+        }
+    }
+    if (frame.keys)
+        sim.position += 0.01f;
+}
+
+// simulation tick: returns true while the object moves
+static bool replayStep(ReplaySim& sim) {
+    if (sim.animating)
+        sim.animationTime += 1.0f / 60.0f;
+    sim.position += sim.velocity / 60.0f + (sim.animating ? 0.001f * std::sin(sim.animationTime * 5.0f) : 0.0f);
+    sim.velocity *= 0.97f;
+    if (sim.velocity > -1e-3f && sim.velocity < 1e-3f)
+        sim.velocity = 0.0f;
+    return sim.velocity != 0.0f || sim.animating;
+}
+
+static uint32_t replayChecksum(const ReplaySim& sim) {
+    uint32_t bits[3];
+    std::memcpy(&bits[0], &sim.position, sizeof(float));
+    std::memcpy(&bits[1], &sim.velocity, sizeof(float));
+    std::memcpy(&bits[2], &sim.animationTime, sizeof(float));
+    return (bits[0] * 2654435761u ^ bits[1]) * 2654435761u ^ bits[2];
+}
+
+// recorded session: the on-demand loop of main, input tagged with the tick it comes before
+// script[i] is the input of loop iteration i, the loop keeps going until tailIterations idle ones
+static uint32_t recordSession(const std::string& path, const std::vector<InputFrame>& script,
+        int tailIterations, unsigned long& ticks) {
+    InputLog log;
+    openInputRecording(log, path.c_str());
+    ReplaySim sim = {0.0f, 0.0f, 0.0f, false, 0.0f};
+    RedrawState redraw = redrawInit(true);
+    for (std::size_t i = 0; i < script.size() + tailIterations; i++) {
+        InputFrame frame = i < script.size() ? script[i] : InputFrame{0, 0.0f, 0, {}};
+        frame.tick = (uint32_t)redraw.frames;
+        writeInputFrame(log, frame);
+        replayApply(sim, redraw, frame);
+        if (redrawDecide(redraw, frame.keys != 0, false))
+            redrawFrameDone(redraw, replayStep(sim));
+    }
+    endInputRecording(log, (uint32_t)redraw.frames);
+    closeInputLog(log);
+    ticks = redraw.frames;
+    return replayChecksum(sim);
+}
+
+// replayed session: the replay loop of main, one tick per iteration until the recording ends
+static uint32_t replaySession(const std::string& path, unsigned long& ticks) {
+    InputLog log;
+    if (!openInputReplay(log, path.c_str()))
+        return 0;
+    ReplaySim sim = {0.0f, 0.0f, 0.0f, false, 0.0f};
+    RedrawState redraw = redrawInit(false);
+    InputFrame frame;
+    while (true) {
+        readInputTick(log, (uint32_t)redraw.frames, frame);
+        replayApply(sim, redraw, frame);
+        if (log.ended)
+            break;
+        if (redrawDecide(redraw, frame.keys != 0, false))
+            redrawFrameDone(redraw, replayStep(sim));
+    }
+    closeInputLog(log);
+    ticks = redraw.frames;
+    return replayChecksum(sim);
+}
+
+// record and replay: a fling keeps moving for many ticks without input, idle iterations in between
+// carry a cursor move, and the session ends long after the last input; the replay has to simulate
+// the same ticks and end in the same state
+static void testReplayFling() {
+    std::string path = (std::filesystem::temp_directory_path() / "renderer_tests_fling.rec").string();
+    InputFrame none = {0, 0.0f, 0, {}};
+    InputFrame move = {0, 0.0f, 0, {{INPUT_CURSOR_MOVE, 0.0, 3.0, 0.0}}};
+    InputFrame press = {0, 0.0f, 0, {{INPUT_MOUSE_PRESS, 0.0, 0.0, 0.0}}};
+    InputFrame held = {0, 0.0f, 1, {}};
+
+    std::vector<InputFrame> script = {move, press};
+    script.insert(script.end(), 20, none);  // fling in flight
+    script.insert(script.end(), 3, held);   // pushed while flying
+    script.insert(script.end(), 400, none); // the fling comes to rest, then idle iterations
+    script.push_back({0, 0.0f, 0, {{INPUT_CURSOR_MOVE, 0.0, -2.0, 0.0}}}); // idle: no tick
+    script.insert(script.end(), 50, none);
+    script.push_back(press);
+
+    unsigned long recordedTicks = 0, replayedTicks = 0;
+    uint32_t recorded = recordSession(path, script, 300, recordedTicks);
+    uint32_t replayed = replaySession(path, replayedTicks);
+    check(recordedTicks > 100, "replay: the fling runs for many ticks without input");
+    check(replayedTicks == recordedTicks, "replay: the replay simulates as many ticks as the recording");
+    check(replayed == recorded, "replay: the replay ends in the recorded state");
+    std::filesystem::remove(path);
+}
+
+// record and replay: "press F3, wait" has a single input, the animation runs on every tick after
+// it until the session ends; the replay has to run all of those ticks, not one per input
+static void testReplayAnimation() {
+    std::string path = (std::filesystem::temp_directory_path() / "renderer_tests_animation.rec").string();
+    InputFrame none = {0, 0.0f, 0, {}};
+    InputFrame toggle = {0, 0.0f, 0, {{INPUT_KEY, 0.0, 0.0, 0.0}}};
+
+    std::vector<InputFrame> script = {toggle};
+    script.insert(script.end(), 500, none);
+
+    unsigned long recordedTicks = 0, replayedTicks = 0;
+    uint32_t recorded = recordSession(path, script, 0, recordedTicks);
+    uint32_t replayed = replaySession(path, replayedTicks);
+    check(recordedTicks == 501, "replay: the animation renders every tick after the key");
+    check(replayedTicks == recordedTicks, "replay: an animation without input replays every tick");
+    check(replayed == recorded, "replay: the animation ends in the recorded state");
+
+    // stopped again: the ticks after the second key are idle and not simulated
+    script.push_back(toggle);
+    script.insert(script.end(), 100, none);
+    recorded = recordSession(path, script, 0, recordedTicks);
+    replayed = replaySession(path, replayedTicks);
+    check(recordedTicks == 502 && replayedTicks == recordedTicks, "replay: a stopped animation stops the ticks");
+    check(replayed == recorded, "replay: the stopped animation ends in the recorded state");
+    std::filesystem::remove(path);
+}
+
+// looping Catmull-Rom track: the velocity just before the seam (last key) has to match the
+// velocity just after it (first key of the next period), so the loop has no kink
+static void testAnimationLoopSeam() {
+    const glm::vec4 points[4] = {
+        glm::vec4(0.0f, 0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.3f, 0.0f, 0.0f),
+        glm::vec4(-0.3f, 0.2f, 0.0f, 0.0f), glm::vec4(-0.2f, -0.3f, 0.0f, 0.0f)
+    };
+    std::vector<Keyframe> keys;
+    for (int i = 0; i <= 4; i++)
+        keys.push_back({(float)i, points[i % 4], glm::vec4(0.0f), CURVE_CATMULL_ROM});
+
+    Animator animator;
+    int track = addAnimationTrack(animator, 0, CHANNEL_TRANSLATION, keys, 0.0f, true);
+    auto sample = [&](float time) {
+        evaluateAnimations(animator, time);
+        return glm::vec2(animator.values[track]);
+    };
+
+    const float STEP = 0.01f;
+    glm::vec2 before = (sample(4.0f - STEP) - sample(4.0f - 2.0f * STEP)) / STEP;
+    glm::vec2 after = (sample(4.0f + 2.0f * STEP) - sample(4.0f + STEP)) / STEP;
+    glm::vec2 expected = (points[1] - points[3]) * 0.5f; // Catmull-Rom tangent at the seam key
+    check(glm::length(before - after) < 0.05f, "animation: the velocity is continuous across the loop seam");
+    check(glm::length(after - glm::vec2(expected)) < 0.05f, "animation: the seam tangent uses the keys around the seam");
+}
+
+// input queue: a burst of cursor moves fills the ring up to the reserve, a button release still
+// gets in after it and every refused event is counted
+static void testInputQueueReserve() {
+    const std::size_t RESERVE = 4;
+    static InputQueue<16> queue;
+    int moves = 0;
+    for (int i = 0; i < 20; i++)
+        moves += queue.push({INPUT_CURSOR_MOVE, 0.0, (double)i, 0.0}, RESERVE);
+    check(moves == 16 - 1 - (int)RESERVE, "input queue: cursor moves stop at the reserve");
+    check(queue.push({INPUT_MOUSE_RELEASE, 0.0, 0.0, 0.0}), "input queue: a release fits into the reserve");
+    check(queue.dropped() == 20 - (unsigned long)moves, "input queue: refused cursor moves are counted");
+
+    InputEvent event;
+    InputEventType last = INPUT_KEY;
+    int popped = 0;
+    while (queue.pop(event)) {
+        last = event.type;
+        popped++;
+    }
+    check(popped == moves + 1 && last == INPUT_MOUSE_RELEASE, "input queue: the release comes out last");
+}
+
+int main() {
+    testRedraw();
+    testGoldenComparison();
+    testReplayFling();
+    testReplayAnimation();
+    testAnimationLoopSeam();
+    testInputQueueReserve();
+
+    if (failures)
+        std::cout << "ERROR: " << failures << " checks failed" << std::endl;
+    else
+        std::cout << "INFO: all checks passed" << std::endl;
+    return failures;
+}
@@ -0,0 +1,18 @@
+// headless golden image check: compare a directory of captured frames against golden images
+// usage: compare_images <results directory> <golden directory> [tolerance] [max bad fraction]
+#include "../src/image_compare.h"
+
+#include <cstdlib>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cout << "usage: " << argv[0] <<
+            " <results directory> <golden directory> [tolerance] [max bad fraction]" << std::endl;
+        return 2;
+    }
+
+    double tolerance = argc > 3 ? std::atof(argv[3]) : 8.0;
+    double maxBadFraction = argc > 4 ? std::atof(argv[4]) : 0.001;
+    return compareWithGolden(argv[1], argv[2], tolerance, maxBadFraction) ? 1 : 0;
+}